@@ -0,0 +1,133 @@
+#include "AsyncExecutor.h"
+#include <algorithm>
+#include <stdexcept>
+#include "Denormals.h"
+
+AsyncExecutor::AsyncExecutor(size_t threads, size_t queueLimit)
+    : threadCount(threads), maxQueued(queueLimit), unfinished(0), stop(false) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    if (maxQueued == 0) throw std::invalid_argument("Queue limit must be positive");
+}
+
+AsyncExecutor::~AsyncExecutor() {
+    std::vector<Job> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+        for (auto& pair : queues)
+            for (auto& job : pair.second.jobs) cancelled.push_back(std::move(job));
+        queues.clear();
+        ready.clear();
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+
+    // обработчики отмененных заданий не вызываются: при завершении программы их
+    // получатели (например, интерпретатор Python) могут быть уже недоступны
+    for (auto& job : cancelled)
+        job.promise.set_exception(std::make_exception_ptr(std::runtime_error("Executor stopped")));
+}
+
+void AsyncExecutor::workerLoop() {
+    ScopedFlushDenormals flushDenormals; // на все время жизни потока, как в ThreadPool
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stop || !ready.empty(); });
+        if (stop) return;
+
+        // ключ не возвращается в ready, пока его задание выполняется: порядок сохраняется
+        const void* key = ready.front();
+        ready.pop_front();
+        KeyQueue& queue = queues[key];
+        Job job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            job.task();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        if (job.done) {
+            try {
+                job.done(error);
+            }
+            catch (...) {
+                // исключение обработчика не должно останавливать поток
+            }
+        }
+        if (error) job.promise.set_exception(error);
+        else job.promise.set_value();
+
+        lock.lock();
+        KeyQueue& q = queues[key];
+        --q.unfinished;
+        --unfinished;
+        if (!q.jobs.empty()) ready.push_back(key);
+        else if (q.unfinished == 0) queues.erase(key);
+        idle.notify_all();
+    }
+}
+
+std::future<void> AsyncExecutor::submit(const void* key, Task task, Completion done) {
+    Job job;
+    job.task = std::move(task);
+    job.done = std::move(done);
+    std::future<void> result = job.promise.get_future();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stop) throw std::logic_error("Executor stopped");
+    if (unfinished >= maxQueued)
+        throw std::length_error("Async queue is full (" + std::to_string(maxQueued) + " jobs)");
+    if (workers.empty()) {
+        workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+            workers.emplace_back(&AsyncExecutor::workerLoop, this);
+    }
+
+    KeyQueue& queue = queues[key];
+    // ключ становится готовым, только если у него нет ни ожидающих, ни выполняемого задания
+    if (queue.unfinished == 0) ready.push_back(key);
+    queue.jobs.push_back(std::move(job));
+    ++queue.unfinished;
+    ++unfinished;
+    wake.notify_one();
+    return result;
+}
+
+std::future<void> AsyncExecutor::processAsync(ProcessingSystem& system, const std::string& blockName,
+    const double* input, double* output, size_t n, Completion done) {
+    ProcessingSystem* sys = &system;
+    return submit(sys, [sys, blockName, input, output, n] {
+        sys->processSignal(blockName, input, output, n);
+    }, std::move(done));
+}
+
+void AsyncExecutor::wait(const void* key) {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [&] {
+        if (!key) return unfinished == 0;
+        return queues.find(key) == queues.end();
+    });
+}
+
+size_t AsyncExecutor::pending(const void* key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!key) return unfinished;
+    auto it = queues.find(key);
+    return (it != queues.end()) ? it->second.unfinished : 0;
+}
+
+void AsyncExecutor::setQueueLimit(size_t limit) {
+    if (limit == 0) throw std::invalid_argument("Queue limit must be positive");
+    std::lock_guard<std::mutex> lock(mutex);
+    maxQueued = limit;
+}
+
+AsyncExecutor& AsyncExecutor::shared() {
+    static AsyncExecutor executor;
+    return executor;
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ProcessingSystem.h"
+
+/**
+ * @brief Исполнитель асинхронных заданий обработки.
+ * @details Задания ставятся в очередь и выполняются собственными потоками исполнителя,
+ * вызывающий поток не блокируется. Каждое задание привязано к ключу (обычно — к системе
+ * обработки): задания с одним ключом выполняются строго в порядке постановки и никогда
+ * одновременно, задания разных ключей — параллельно. Число незавершенных заданий
+ * ограничено, при переполнении новое задание не принимается.
+ */
+class AsyncExecutor {
+public:
+    /** @brief Тело задания. */
+    typedef std::function<void()> Task;
+
+    /**
+     * @brief Обработчик завершения задания.
+     * @details Вызывается в потоке исполнителя сразу после задания (до готовности future);
+     * аргумент — исключение задания или пустой указатель при успехе.
+     */
+    typedef std::function<void(std::exception_ptr error)> Completion;
+
+private:
+    struct Job {
+        Task task;
+        Completion done;
+        std::promise<void> promise;
+    };
+
+    /** @brief Очередь заданий одного ключа. */
+    struct KeyQueue {
+        std::deque<Job> jobs;   /**< Ожидающие задания */
+        size_t unfinished = 0;  /**< Ожидающие и выполняемое задания */
+    };
+
+    size_t threadCount;                                   /**< Число потоков исполнителя */
+    std::vector<std::thread> workers;                     /**< Потоки (создаются при первом задании) */
+    mutable std::mutex mutex;                             /**< Защищает все поля ниже */
+    std::condition_variable wake;                         /**< Сигнал о готовом ключе */
+    std::condition_variable idle;                         /**< Сигнал о завершении задания */
+    std::unordered_map<const void*, KeyQueue> queues;     /**< Очереди по ключам */
+    std::deque<const void*> ready;                        /**< Ключи с заданиями, готовыми к запуску */
+    size_t maxQueued;                                     /**< Наибольшее число незавершенных заданий */
+    size_t unfinished;                                    /**< Всего незавершенных заданий */
+    bool stop;                                            /**< Признак остановки */
+
+    void workerLoop();
+
+public:
+    /**
+     * @brief Конструктор исполнителя.
+     * @param threads Число потоков (0 — по числу процессоров).
+     * @param queueLimit Наибольшее число незавершенных заданий.
+     */
+    explicit AsyncExecutor(size_t threads = 0, size_t queueLimit = 1024);
+
+    /**
+     * @brief Деструктор: ожидающие задания отменяются (их future получают исключение),
+     * выполняемые — завершаются.
+     */
+    ~AsyncExecutor();
+
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+    /**
+     * @brief Ставит задание в очередь.
+     * @param key Ключ упорядочивания (задания одного ключа выполняются последовательно).
+     * @param task Задание.
+     * @param done Обработчик завершения (может быть пустым).
+     * @return future, готовый после завершения задания (с исключением задания, если оно было).
+     * @throw std::length_error Если достигнут предел числа незавершенных заданий.
+     */
+    std::future<void> submit(const void* key, Task task, Completion done = Completion());
+
+    /**
+     * @brief Асинхронный вызов ProcessingSystem::processSignal.
+     * @details Буферы input и output должны оставаться действительными до завершения;
+     * система не должна использоваться синхронно, пока у нее есть незавершенные задания.
+     * @param system Система обработки (ключ упорядочивания).
+     * @param blockName Имя блока.
+     * @param input Входные отсчеты.
+     * @param output Буфер для выходных отсчетов.
+     * @param n Количество отсчетов.
+     * @param done Обработчик завершения (может быть пустым).
+     * @return future завершения.
+     * @throw std::length_error Если очередь заполнена.
+     */
+    std::future<void> processAsync(ProcessingSystem& system, const std::string& blockName,
+        const double* input, double* output, size_t n, Completion done = Completion());
+
+    /**
+     * @brief Ожидает завершения всех заданий ключа (или всех заданий при key == nullptr).
+     * @param key Ключ упорядочивания.
+     */
+    void wait(const void* key);
+
+    /**
+     * @brief Количество незавершенных заданий ключа (или всех при key == nullptr).
+     * @param key Ключ упорядочивания.
+     * @return Число ожидающих и выполняемых заданий.
+     */
+    size_t pending(const void* key) const;
+
+    /**
+     * @brief Задает предел числа незавершенных заданий.
+     * @param limit Новый предел (больше нуля).
+     * @throw std::invalid_argument Если limit равен нулю.
+     */
+    void setQueueLimit(size_t limit);
+
+    /**
+     * @brief Общий исполнитель библиотеки (потоки создаются при первом задании).
+     * @return Исполнитель с потоками по числу процессоров.
+     */
+    static AsyncExecutor& shared();
+};
@@ -0,0 +1,55 @@
+#include "BatchProcessor.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include "ThreadPool.h"
+
+// отмена проверяется между порциями, чтобы длинный сигнал не задерживал ее надолго
+static const size_t CHUNK = 1 << 16;
+
+bool BatchProcessor::run(const ProcessingSystem& system, const std::string& blockName,
+    const std::vector<const double*>& inputs, const std::vector<double*>& outputs,
+    const std::vector<size_t>& lengths, size_t threads, const ProgressCallback& progress) {
+    if (inputs.size() != outputs.size() || inputs.size() != lengths.size())
+        throw std::invalid_argument("Batch inputs, outputs and lengths must have the same size");
+    size_t total = inputs.size();
+    if (total == 0) return true;
+
+    // проверка до запуска потоков: понятная ошибка вместо исключения из рабочего потока
+    if (!system.hasBlock(blockName)) throw std::logic_error("Block not found: " + blockName);
+
+    ThreadPool& pool = ThreadPool::shared();
+    size_t workers = (threads == 0) ? pool.size() : std::min(threads, pool.size());
+    workers = std::min(workers, total);
+
+    std::vector<std::unique_ptr<ProcessingSystem>> local(pool.size());
+    std::atomic<bool> cancelled(false);
+    std::mutex progressMutex;
+    size_t completed = 0;
+
+    pool.parallelFor(total, [&](size_t job, size_t worker) {
+        if (cancelled.load(std::memory_order_relaxed)) return;
+
+        // копия графа создается в рабочем потоке (первое касание памяти — на его узле)
+        std::unique_ptr<ProcessingSystem>& sys = local[worker];
+        if (!sys) sys = system.clone();
+        sys->resetAll();
+
+        const double* in = inputs[job];
+        double* out = outputs[job];
+        for (size_t pos = 0; pos < lengths[job]; pos += CHUNK) {
+            if (cancelled.load(std::memory_order_relaxed)) return;
+            sys->processSignal(blockName, in + pos, out + pos, std::min(CHUNK, lengths[job] - pos));
+        }
+
+        if (progress) {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            ++completed;
+            if (!cancelled.load() && !progress(completed, total)) cancelled.store(true);
+        }
+    }, workers);
+
+    return !cancelled.load();
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "ProcessingSystem.h"
+
+/**
+ * @brief Пакетная (офлайн) обработка множества независимых сигналов.
+ * @details Каждое задание — отдельный сигнал, обрабатываемый так, как если бы перед ним
+ * был вызван resetAll. Граф копируется один раз на рабочий поток (ProcessingSystem::clone),
+ * копия создается внутри потока, поэтому память состояния фильтров выделяется на его
+ * NUMA-узле. Задания раздаются потокам общего пула ThreadPool динамически.
+ */
+class BatchProcessor {
+public:
+    /**
+     * @brief Обработчик прогресса: количество завершенных заданий и их общее число.
+     * @details Вызывается после каждого завершенного задания из рабочих потоков,
+     * но никогда одновременно (вызовы сериализованы). Возврат false отменяет обработку.
+     */
+    typedef std::function<bool(size_t completed, size_t total)> ProgressCallback;
+
+    /**
+     * @brief Обрабатывает набор сигналов на выходе указанного блока.
+     * @param system Система-образец (не изменяется).
+     * @param blockName Имя блока, выход которого записывается в outputs.
+     * @param inputs Входные сигналы заданий.
+     * @param outputs Буферы для выходных сигналов (той же длины, что и входы).
+     * @param lengths Длины сигналов.
+     * @param threads Наибольшее число потоков (0 — все потоки общего пула).
+     * @param progress Обработчик прогресса и отмены (может быть пустым).
+     * @return true, если обработаны все задания; false, если обработка отменена.
+     * @throw std::invalid_argument Если размеры массивов заданий не совпадают.
+     * @throw std::logic_error Если блок не найден или граф не поддерживает копирование.
+     */
+    static bool run(const ProcessingSystem& system, const std::string& blockName,
+        const std::vector<const double*>& inputs, const std::vector<double*>& outputs,
+        const std::vector<size_t>& lengths, size_t threads = 0,
+        const ProgressCallback& progress = ProgressCallback());
+};
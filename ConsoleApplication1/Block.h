@@ -1,6 +1,10 @@
 #pragma once
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include "TransferFunction.h"
 
 /**
  * @brief Абстрактный базовый класс "Блок обработки сигналов".
@@ -45,4 +49,66 @@ public:
      * подготавливая блок к обработке новой последовательности данных.
      */
     virtual void reset() = 0;
+
+    /**
+     * @brief Блочная обработка сигнала для блоков с одним входом.
+     * @details Эквивалентна n вызовам process({ input[i] }). Реализация по умолчанию
+     * вызывает process в цикле; блоки с дешевым потоковым алгоритмом переопределяют
+     * метод, чтобы избежать накладных расходов на каждый отсчет.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для выходных отсчетов (может совпадать с input).
+     * @param n Количество отсчетов.
+     */
+    virtual void processBlock(const double* input, double* output, size_t n) {
+        std::vector<double> in(1);
+        for (size_t i = 0; i < n; ++i) {
+            in[0] = input[i];
+            output[i] = process(in);
+        }
+    }
+
+    /**
+     * @brief Длина памяти блока: от скольких предыдущих входных отсчетов зависит выход.
+     * @details Если выход в момент t однозначно определяется входами x[t - length] ... x[t]
+     * (как у КИХ-фильтра), длинный сигнал можно разрезать на участки и обрабатывать их
+     * параллельно, «прогревая» копию блока length предшествующими отсчетами. Блоки с
+     * рекурсивным или накопленным состоянием (БИХ-фильтры, скользящая сумма) возвращают false.
+     * @param length Количество предыдущих отсчетов, от которых зависит выход.
+     * @return true, если память блока конечна и length заполнено.
+     */
+    virtual bool getHistoryLength(size_t& length) const {
+        (void)length;
+        return false;
+    }
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @details Используется для размножения графа по рабочим потокам
+     * (ProcessingSystem::clone). Блоки, не поддерживающие копирование, возвращают nullptr.
+     * @return Новый блок того же типа или nullptr.
+     */
+    virtual std::unique_ptr<Block> clone() const { return nullptr; }
+
+    /**
+     * @brief Перенаправление ссылок на другие блоки после копирования графа.
+     * @details Блоки, хранящие указатели на другие блоки системы (например, STFT -> ISTFT),
+     * заменяют их на соответствующие копии.
+     * @param map Соответствие «исходный блок -> копия».
+     */
+    virtual void remapLinks(const std::unordered_map<const Block*, Block*>& map) { (void)map; }
+
+    /**
+     * @brief Передаточная функция выхода блока относительно внешнего входа системы.
+     * @details Используется модулем анализа (FilterAnalysis) для построения частотных
+     * характеристик отдельных блоков и целых графов. Линейные стационарные блоки
+     * переопределяют метод; для остальных блоков он возвращает false.
+     * @param inputs Передаточные функции от внешнего входа к каждому входу блока.
+     * @param out Результирующая передаточная функция от внешнего входа к выходу блока.
+     * @return true, если блок линейный и передаточная функция вычислена.
+     */
+    virtual bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const {
+        (void)inputs;
+        (void)out;
+        return false;
+    }
 };
\ No newline at end of file
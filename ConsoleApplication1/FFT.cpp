@@ -0,0 +1,129 @@
+#include "FFT.h"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+static const double PI = 3.14159265358979323846;
+
+static bool isPowerOfTwo(size_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+FFTPlan::FFTPlan(size_t length) : n(length), pow2(isPowerOfTwo(length)) {
+    if (n == 0) throw std::invalid_argument("FFT length must be positive");
+
+    if (pow2) {
+        // поворачивающие множители для половины окружности
+        twiddle.resize(n / 2);
+        for (size_t k = 0; k < n / 2; ++k) {
+            double ang = -2.0 * PI * static_cast<double>(k) / static_cast<double>(n);
+            twiddle[k] = std::complex<double>(std::cos(ang), std::sin(ang));
+        }
+
+        // таблица бит-реверсной перестановки
+        bitrev.resize(n);
+        size_t bits = 0;
+        while ((size_t(1) << bits) < n) ++bits;
+        for (size_t i = 0; i < n; ++i) {
+            size_t r = 0;
+            for (size_t b = 0; b < bits; ++b)
+                if (i & (size_t(1) << b)) r |= size_t(1) << (bits - 1 - b);
+            bitrev[i] = r;
+        }
+        return;
+    }
+
+    // алгоритм Блюстейна: свертка с chirp-последовательностью через БПФ длины m >= 2n-1
+    size_t m = 1;
+    while (m < 2 * n - 1) m <<= 1;
+    inner = get(m);
+
+    chirp.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        // k^2 mod 2n, чтобы аргумент не терял точность при больших k
+        size_t k2 = static_cast<size_t>((static_cast<unsigned long long>(k) * k) % (2 * n));
+        double ang = -PI * static_cast<double>(k2) / static_cast<double>(n);
+        chirp[k] = std::complex<double>(std::cos(ang), std::sin(ang));
+    }
+
+    chirpFFT.assign(m, std::complex<double>(0.0, 0.0));
+    chirpFFT[0] = std::conj(chirp[0]);
+    for (size_t k = 1; k < n; ++k) {
+        chirpFFT[k] = std::conj(chirp[k]);
+        chirpFFT[m - k] = std::conj(chirp[k]);
+    }
+    inner->forward(chirpFFT.data());
+}
+
+void FFTPlan::radix2(std::complex<double>* data, bool inverse) const {
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = bitrev[i];
+        if (i < j) std::swap(data[i], data[j]);
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1) {
+        size_t half = len / 2;
+        size_t step = n / len;
+        for (size_t start = 0; start < n; start += len) {
+            for (size_t j = 0; j < half; ++j) {
+                std::complex<double> w = twiddle[j * step];
+                if (inverse) w = std::conj(w);
+                std::complex<double> t = w * data[start + j + half];
+                data[start + j + half] = data[start + j] - t;
+                data[start + j] += t;
+            }
+        }
+    }
+}
+
+void FFTPlan::bluestein(std::complex<double>* data, bool inverse) const {
+    size_t m = inner->size();
+    std::vector<std::complex<double>> work(m, std::complex<double>(0.0, 0.0));
+
+    // обратное преобразование сводится к прямому через сопряжение
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<double> x = inverse ? std::conj(data[k]) : data[k];
+        work[k] = x * chirp[k];
+    }
+
+    inner->forward(work.data());
+    for (size_t k = 0; k < m; ++k) work[k] *= chirpFFT[k];
+    inner->inverse(work.data());
+
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<double> y = work[k] * chirp[k];
+        data[k] = inverse ? std::conj(y) : y;
+    }
+}
+
+void FFTPlan::forward(std::complex<double>* data) const {
+    if (pow2) radix2(data, false);
+    else bluestein(data, false);
+}
+
+void FFTPlan::inverse(std::complex<double>* data) const {
+    if (pow2) radix2(data, true);
+    else bluestein(data, true);
+
+    double scale = 1.0 / static_cast<double>(n);
+    for (size_t k = 0; k < n; ++k) data[k] *= scale;
+}
+
+std::shared_ptr<const FFTPlan> FFTPlan::get(size_t length) {
+    static std::mutex mtx;
+    static std::map<size_t, std::shared_ptr<const FFTPlan>> cache;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = cache.find(length);
+        if (it != cache.end()) return it->second;
+    }
+
+    // план строится вне блокировки: Блюстейн рекурсивно запрашивает вложенный план
+    auto plan = std::make_shared<const FFTPlan>(length);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto res = cache.emplace(length, plan);
+    return res.first->second;
+}
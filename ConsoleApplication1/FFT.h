@@ -0,0 +1,64 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief План быстрого преобразования Фурье (БПФ) фиксированной длины.
+ * @details Хранит заранее вычисленные поворачивающие множители и таблицу
+ * бит-реверсной перестановки. Для длин, равных степени двойки, используется
+ * итеративный алгоритм Кули–Тьюки по основанию 2; для остальных длин —
+ * алгоритм Блюстейна (chirp-z) поверх плана длины степени двойки.
+ * Планы неизменяемы после создания и могут разделяться между потоками.
+ */
+class FFTPlan {
+private:
+    size_t n;                                   /**< Длина преобразования */
+    bool pow2;                                  /**< Признак длины, равной степени двойки */
+    std::vector<std::complex<double>> twiddle;  /**< Поворачивающие множители exp(-2*pi*i*k/n), k < n/2 */
+    std::vector<size_t> bitrev;                 /**< Таблица бит-реверсной перестановки */
+
+    // Данные алгоритма Блюстейна (используются только при pow2 == false)
+    std::vector<std::complex<double>> chirp;    /**< Последовательность exp(-pi*i*k^2/n) */
+    std::vector<std::complex<double>> chirpFFT; /**< Спектр сопряженной chirp-последовательности */
+    std::shared_ptr<const FFTPlan> inner;       /**< Вложенный план длины степени двойки */
+
+    void radix2(std::complex<double>* data, bool inverse) const;
+    void bluestein(std::complex<double>* data, bool inverse) const;
+
+public:
+    /**
+     * @brief Конструктор плана БПФ.
+     * @param length Длина преобразования (больше нуля).
+     * @throw std::invalid_argument Если длина равна нулю.
+     */
+    explicit FFTPlan(size_t length);
+
+    /**
+     * @brief Получить длину преобразования.
+     * @return Количество точек БПФ.
+     */
+    size_t size() const { return n; }
+
+    /**
+     * @brief Прямое БПФ на месте: X[k] = Σ x[t] * exp(-2*pi*i*k*t/n).
+     * @param data Массив из size() комплексных отсчетов.
+     */
+    void forward(std::complex<double>* data) const;
+
+    /**
+     * @brief Обратное БПФ на месте с нормировкой на 1/n.
+     * @param data Массив из size() комплексных отсчетов.
+     */
+    void inverse(std::complex<double>* data) const;
+
+    /**
+     * @brief Получить план заданной длины из общего кэша.
+     * @details Повторные запросы одной длины возвращают один и тот же объект,
+     * поэтому тригонометрические таблицы вычисляются один раз на процесс.
+     * @param length Длина преобразования.
+     * @return Разделяемый указатель на неизменяемый план.
+     */
+    static std::shared_ptr<const FFTPlan> get(size_t length);
+};
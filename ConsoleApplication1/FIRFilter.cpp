@@ -32,3 +32,18 @@ void FIRFilter::reset() {
 	std::fill(xbuf.begin(), xbuf.end(), 0.0); // сброс буфера входных значений
 }
 
+
+bool FIRFilter::getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const {
+	assert(inputs.size() == 1);
+	out = inputs[0].cascade(TransferFunction{ b, { 1.0 } }); // H(z) = B(z)
+	return true;
+}
+
+bool FIRFilter::getHistoryLength(size_t& length) const {
+	length = b.size() - 1;
+	return true;
+}
+
+std::unique_ptr<Block> FIRFilter::clone() const {
+	return std::make_unique<FIRFilter>(*this);
+}
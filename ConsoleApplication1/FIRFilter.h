@@ -33,6 +33,27 @@ public:
      */
     void reset() override;
 
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+
+    /**
+     * @brief Память фильтра: выход зависит от текущего и N предыдущих отсчетов.
+     * @param length Число коэффициентов минус один.
+     * @return Всегда true.
+     */
+    bool getHistoryLength(size_t& length) const override;
+
+    /**
+     * @brief Передаточная функция блока с учетом передаточной функции его входа.
+     * @param inputs Передаточные функции входов. Ожидается размер, равный 1.
+     * @param out Передаточная функция выхода: H_in(z) * B(z).
+     * @return Всегда true: блок линейный.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override;
+
     /**
      * @brief Перегрузка оператора вызова функции "()".
      * @details Позволяет использовать объект фильтра как функцию для обработки одиночных значений.
@@ -0,0 +1,240 @@
+#include "FilterAnalysis.h"
+#include "FFT.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+typedef std::complex<double> cplx;
+
+static const double PI = 3.14159265358979323846;
+
+/*
+ * Спектры двух вещественных полиномов p и q одним комплексным БПФ длины nfft:
+ * z = p + i*q, P[k] = (Z[k] + conj(Z[-k])) / 2, Q[k] = (Z[k] - conj(Z[-k])) / 2i.
+ * Коэффициенты с индексом >= nfft сворачиваются по модулю nfft (e^-jwn периодична).
+ */
+static void spectraPair(const std::vector<double>& p, const std::vector<double>& q,
+    size_t nfft, size_t nOut, std::vector<cplx>& P, std::vector<cplx>& Q) {
+    std::vector<cplx> z(nfft, cplx(0.0, 0.0));
+    for (size_t i = 0; i < p.size(); ++i) z[i % nfft] += cplx(p[i], 0.0);
+    for (size_t i = 0; i < q.size(); ++i) z[i % nfft] += cplx(0.0, q[i]);
+
+    FFTPlan::get(nfft)->forward(z.data());
+
+    P.resize(nOut);
+    Q.resize(nOut);
+    for (size_t k = 0; k < nOut; ++k) {
+        cplx zk = z[k];
+        cplx zr = std::conj(z[(nfft - k) % nfft]);
+        P[k] = 0.5 * (zk + zr);
+        Q[k] = cplx(0.0, -0.5) * (zk - zr);
+    }
+}
+
+static void checkDenominator(const TransferFunction& tf) {
+    if (tf.a.empty()) throw std::invalid_argument("Denominator must not be empty");
+}
+
+std::vector<cplx> FilterAnalysis::frequencyResponse(const TransferFunction& tf, size_t nPoints) {
+    if (nPoints == 0) throw std::invalid_argument("Number of frequency points must be positive");
+    checkDenominator(tf);
+
+    std::vector<cplx> B, A;
+    spectraPair(tf.b, tf.a, 2 * nPoints, nPoints, B, A);
+
+    std::vector<cplx> H(nPoints);
+    for (size_t k = 0; k < nPoints; ++k)
+        H[k] = B[k] / A[k];
+    return H;
+}
+
+std::vector<cplx> FilterAnalysis::frequencyResponseAt(const TransferFunction& tf, const std::vector<double>& omegas) {
+    checkDenominator(tf);
+
+    std::vector<cplx> H(omegas.size());
+    for (size_t k = 0; k < omegas.size(); ++k) {
+        // схема Горнера по переменной z^-1 = e^-jw
+        cplx zi = std::polar(1.0, -omegas[k]);
+        cplx num(0.0, 0.0), den(0.0, 0.0);
+        for (size_t i = tf.b.size(); i-- > 0;) num = num * zi + tf.b[i];
+        for (size_t i = tf.a.size(); i-- > 0;) den = den * zi + tf.a[i];
+        H[k] = num / den;
+    }
+    return H;
+}
+
+void FilterAnalysis::magnitudePhase(const TransferFunction& tf, size_t nPoints, double* magnitude, double* phase) {
+    std::vector<cplx> H = frequencyResponse(tf, nPoints);
+
+    double prev = 0.0;
+    double offset = 0.0;
+    for (size_t k = 0; k < nPoints; ++k) {
+        if (magnitude) magnitude[k] = std::abs(H[k]);
+        if (phase) {
+            // развертывание фазы: устраняем скачки на 2*pi между соседними точками
+            double ph = std::arg(H[k]);
+            if (k > 0) {
+                double d = ph - prev;
+                double dmod = std::fmod(d + PI, 2.0 * PI);
+                if (dmod < 0.0) dmod += 2.0 * PI;
+                dmod -= PI;
+                if (dmod == -PI && d > 0.0) dmod = PI;
+                offset += dmod - d;
+            }
+            prev = ph;
+            phase[k] = ph + offset;
+        }
+    }
+}
+
+std::vector<double> FilterAnalysis::groupDelay(const TransferFunction& tf, size_t nPoints) {
+    if (nPoints == 0) throw std::invalid_argument("Number of frequency points must be positive");
+    checkDenominator(tf);
+
+    std::vector<double> nb(tf.b.size()), na(tf.a.size());
+    for (size_t i = 0; i < nb.size(); ++i) nb[i] = static_cast<double>(i) * tf.b[i];
+    for (size_t i = 0; i < na.size(); ++i) na[i] = static_cast<double>(i) * tf.a[i];
+
+    size_t nfft = 2 * nPoints;
+    std::vector<cplx> B, A, NB, NA;
+    spectraPair(tf.b, tf.a, nfft, nPoints, B, A);
+    spectraPair(nb, na, nfft, nPoints, NB, NA);
+
+    const double eps = 1e-300;
+    std::vector<double> gd(nPoints, 0.0);
+    for (size_t k = 0; k < nPoints; ++k) {
+        if (std::abs(B[k]) < eps || std::abs(A[k]) < eps) continue; // особая точка
+        gd[k] = (NB[k] / B[k]).real() - (NA[k] / A[k]).real();
+    }
+    return gd;
+}
+
+static std::vector<double> filterResponse(const TransferFunction& tf, size_t length, bool step) {
+    checkDenominator(tf);
+    if (tf.a[0] == 0.0) throw std::invalid_argument("Leading denominator coefficient must not be zero");
+
+    const std::vector<double>& b = tf.b;
+    const std::vector<double>& a = tf.a;
+    double inv = 1.0 / a[0];
+
+    std::vector<double> y(length, 0.0);
+    for (size_t n = 0; n < length; ++n) {
+        double acc = 0.0;
+        // вход: импульс x[n] = (n == 0) или ступенька x[n] = 1
+        for (size_t i = 0; i < b.size() && i <= n; ++i)
+            if (step || i == n) acc += b[i];
+        for (size_t j = 1; j < a.size() && j <= n; ++j)
+            acc -= a[j] * y[n - j];
+        y[n] = acc * inv;
+    }
+    return y;
+}
+
+std::vector<double> FilterAnalysis::impulseResponse(const TransferFunction& tf, size_t length) {
+    return filterResponse(tf, length, false);
+}
+
+std::vector<double> FilterAnalysis::stepResponse(const TransferFunction& tf, size_t length) {
+    return filterResponse(tf, length, true);
+}
+
+std::vector<cplx> FilterAnalysis::roots(const std::vector<double>& c) {
+    // c[0]*z^N + c[1]*z^(N-1) + ... + c[N]: коэффициенты по убыванию степеней z
+    size_t first = 0;
+    while (first < c.size() && c[first] == 0.0) ++first; // корни в бесконечности
+    size_t last = c.size();
+    while (last > first && c[last - 1] == 0.0) --last;
+
+    std::vector<cplx> result;
+    if (first >= last) return result;
+
+    for (size_t i = last; i < c.size(); ++i) result.push_back(cplx(0.0, 0.0)); // корни в нуле
+
+    // нормированный (приведенный) полином степени d
+    size_t d = last - first - 1;
+    if (d == 0) return result;
+    std::vector<double> p(d + 1);
+    for (size_t i = 0; i <= d; ++i) p[i] = c[first + i] / c[first];
+
+    if (d == 1) {
+        result.push_back(cplx(-p[1], 0.0));
+        return result;
+    }
+
+    // начальное приближение: точки на окружности радиуса среднего геометрического корней
+    double r = std::pow(std::abs(p[d]), 1.0 / static_cast<double>(d));
+    if (r == 0.0 || !std::isfinite(r)) r = 1.0;
+    std::vector<cplx> z(d);
+    for (size_t k = 0; k < d; ++k)
+        z[k] = std::polar(r, 2.0 * PI * static_cast<double>(k) / static_cast<double>(d) + 0.4);
+
+    // итерации Аберта–Эрлиха (кубическая сходимость для простых корней);
+    // сошедшиеся корни больше не уточняются
+    std::vector<char> done(d, 0);
+    for (int iter = 0; iter < 500; ++iter) {
+        size_t active = 0;
+        for (size_t k = 0; k < d; ++k) {
+            if (done[k]) continue;
+            ++active;
+            cplx pv(1.0, 0.0), dv(0.0, 0.0);
+            for (size_t i = 1; i <= d; ++i) {
+                dv = dv * z[k] + pv;
+                pv = pv * z[k] + p[i];
+            }
+            if (pv == cplx(0.0, 0.0)) { done[k] = 1; continue; } // точный корень
+
+            cplx ratio = pv / dv;
+            cplx sum(0.0, 0.0);
+            for (size_t j = 0; j < d; ++j)
+                if (j != k) sum += 1.0 / (z[k] - z[j]);
+            cplx w = ratio / (1.0 - ratio * sum);
+            if (!std::isfinite(w.real()) || !std::isfinite(w.imag())) continue;
+
+            z[k] -= w;
+            if (std::abs(w) <= 1e-15 * std::max(1.0, std::abs(z[k]))) done[k] = 1;
+        }
+        if (active == 0) break;
+    }
+
+    // чистка мнимой части у вещественных корней
+    for (size_t k = 0; k < d; ++k) {
+        if (std::abs(z[k].imag()) <= 1e-12 * std::max(1.0, std::abs(z[k])))
+            z[k] = cplx(z[k].real(), 0.0);
+        result.push_back(z[k]);
+    }
+    return result;
+}
+
+std::vector<cplx> FilterAnalysis::zeros(const TransferFunction& tf) {
+    std::vector<double> b = tf.b;
+    if (b.size() < tf.a.size()) b.resize(tf.a.size(), 0.0);
+    return roots(b);
+}
+
+std::vector<cplx> FilterAnalysis::poles(const TransferFunction& tf) {
+    std::vector<double> a = tf.a;
+    if (a.size() < tf.b.size()) a.resize(tf.b.size(), 0.0);
+    return roots(a);
+}
+
+bool FilterAnalysis::isStable(const TransferFunction& tf) {
+    checkDenominator(tf);
+    if (tf.a[0] == 0.0) return false;
+
+    std::vector<double> a(tf.a);
+    while (a.size() > 1 && a.back() == 0.0) a.pop_back(); // полюса в нуле не влияют на устойчивость
+    for (size_t i = 1; i < a.size(); ++i) a[i] /= a[0];
+    a[0] = 1.0;
+
+    // понижение порядка (обратная рекурсия Левинсона): k_m = a_m
+    for (size_t m = a.size() - 1; m > 0; --m) {
+        double k = a[m];
+        if (std::abs(k) >= 1.0) return false;
+        double den = 1.0 - k * k;
+        std::vector<double> next(m);
+        for (size_t i = 0; i < m; ++i)
+            next[i] = (a[i] - k * a[m - i]) / den;
+        a.swap(next);
+    }
+    return true;
+}
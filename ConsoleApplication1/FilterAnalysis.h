@@ -0,0 +1,111 @@
+#pragma once
+#include <complex>
+#include <vector>
+#include "TransferFunction.h"
+
+/**
+ * @brief Набор процедур анализа линейных фильтров и графов обработки.
+ * @details Вычисляет частотную (АЧХ/ФЧХ), групповую задержку, импульсную и переходную
+ * характеристики, нули и полюса, а также проверяет устойчивость передаточной функции.
+ * Частотные характеристики на равномерной сетке вычисляются через БПФ (см. FFTPlan),
+ * что позволяет за один вызов получать тысячи точек для интерактивного построения графиков.
+ *
+ * Равномерная сетка частот: w[k] = pi * k / nPoints, k = 0 ... nPoints-1 (рад/отсчет),
+ * т.е. от нуля до частоты Найквиста (не включая ее).
+ */
+class FilterAnalysis {
+public:
+    /**
+     * @brief Комплексная частотная характеристика H(e^jw) на равномерной сетке.
+     * @details Числитель и знаменатель вычисляются одним комплексным БПФ длины 2*nPoints;
+     * полиномы длиннее сетки сворачиваются по модулю длины БПФ без потери точности.
+     * @param tf Передаточная функция.
+     * @param nPoints Количество точек сетки (больше нуля).
+     * @return Вектор из nPoints комплексных значений H.
+     * @throw std::invalid_argument Если nPoints равно нулю или знаменатель пуст.
+     */
+    static std::vector<std::complex<double>> frequencyResponse(const TransferFunction& tf, size_t nPoints);
+
+    /**
+     * @brief Комплексная частотная характеристика на произвольном наборе частот.
+     * @details Прямое вычисление полиномов схемой Горнера; подходит для неравномерных сеток.
+     * @param tf Передаточная функция.
+     * @param omegas Частоты в рад/отсчет.
+     * @return Вектор значений H(e^jw) той же длины, что и omegas.
+     */
+    static std::vector<std::complex<double>> frequencyResponseAt(const TransferFunction& tf, const std::vector<double>& omegas);
+
+    /**
+     * @brief Амплитудная и развернутая фазовая характеристики на равномерной сетке.
+     * @param tf Передаточная функция.
+     * @param nPoints Количество точек сетки.
+     * @param magnitude Массив для |H| (nPoints элементов) или nullptr.
+     * @param phase Массив для развернутой фазы arg H в радианах (nPoints элементов) или nullptr.
+     */
+    static void magnitudePhase(const TransferFunction& tf, size_t nPoints, double* magnitude, double* phase);
+
+    /**
+     * @brief Групповая задержка -d(arg H)/dw в отсчетах на равномерной сетке.
+     * @details Вычисляется аналитически: Re(FFT(n*b) / FFT(b)) - Re(FFT(n*a) / FFT(a)).
+     * В точках, где числитель или знаменатель обращается в ноль, возвращается 0.
+     * @param tf Передаточная функция.
+     * @param nPoints Количество точек сетки.
+     * @return Вектор из nPoints значений задержки.
+     */
+    static std::vector<double> groupDelay(const TransferFunction& tf, size_t nPoints);
+
+    /**
+     * @brief Импульсная характеристика (отклик на единичный импульс при нулевом состоянии).
+     * @param tf Передаточная функция.
+     * @param length Количество вычисляемых отсчетов.
+     * @return Вектор отсчетов h[0] ... h[length-1].
+     * @throw std::invalid_argument Если a[0] равен нулю.
+     */
+    static std::vector<double> impulseResponse(const TransferFunction& tf, size_t length);
+
+    /**
+     * @brief Переходная характеристика (отклик на единичную ступеньку при нулевом состоянии).
+     * @param tf Передаточная функция.
+     * @param length Количество вычисляемых отсчетов.
+     * @return Вектор отсчетов s[0] ... s[length-1].
+     * @throw std::invalid_argument Если a[0] равен нулю.
+     */
+    static std::vector<double> stepResponse(const TransferFunction& tf, size_t length);
+
+    /**
+     * @brief Корни полинома, заданного по степеням z^-1 (c[0] + c[1]*z^-1 + ...).
+     * @details Корни ищутся относительно z методом Аберта–Эрлиха. Нулевые младшие
+     * коэффициенты c[0] (корни в бесконечности) отбрасываются, нулевые старшие
+     * коэффициенты дают корни в точке z = 0.
+     * @param c Коэффициенты полинома.
+     * @return Найденные корни (комплексно-сопряженные пары для вещественных коэффициентов).
+     */
+    static std::vector<std::complex<double>> roots(const std::vector<double>& c);
+
+    /**
+     * @brief Нули передаточной функции.
+     * @details Числитель дополняется до длины знаменателя, поэтому разница порядков
+     * дает нули в точке z = 0 (как в scipy.signal.tf2zpk).
+     * @param tf Передаточная функция.
+     * @return Комплексные нули.
+     */
+    static std::vector<std::complex<double>> zeros(const TransferFunction& tf);
+
+    /**
+     * @brief Полюса передаточной функции.
+     * @details Знаменатель дополняется до длины числителя (полюса в точке z = 0).
+     * @param tf Передаточная функция.
+     * @return Комплексные полюса.
+     */
+    static std::vector<std::complex<double>> poles(const TransferFunction& tf);
+
+    /**
+     * @brief Проверка устойчивости по критерию Шура–Кона.
+     * @details Выполняет понижение порядка знаменателя через коэффициенты отражения;
+     * система устойчива, если все коэффициенты отражения по модулю меньше единицы
+     * (все полюса строго внутри единичной окружности). Не требует поиска корней.
+     * @param tf Передаточная функция.
+     * @return true, если система устойчива.
+     */
+    static bool isStable(const TransferFunction& tf);
+};
@@ -0,0 +1,1005 @@
+#include "FilterDesign.h"
+#include "FFT.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+typedef std::complex<double> cplx;
+
+static const double PI = 3.14159265358979323846;
+
+// ===== Кэш результатов проектирования =====
+
+/*
+ * Ключ кэша — полная спецификация, упакованная в вектор чисел
+ * (идентификатор метода, затем все параметры по порядку).
+ */
+typedef std::vector<double> SpecKey;
+
+static const size_t MAX_CACHE_ENTRIES = 256;
+
+static std::mutex g_cacheMutex;
+static std::map<SpecKey, std::shared_ptr<const std::vector<double>>> g_firCache;
+static std::map<SpecKey, std::shared_ptr<const IIRDesign>> g_iirCache;
+
+template <typename T>
+static std::shared_ptr<const T> cacheLookup(std::map<SpecKey, std::shared_ptr<const T>>& cache, const SpecKey& key) {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    auto it = cache.find(key);
+    return it != cache.end() ? it->second : nullptr;
+}
+
+template <typename T>
+static void cacheStore(std::map<SpecKey, std::shared_ptr<const T>>& cache, const SpecKey& key, std::shared_ptr<const T> value) {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    if (cache.size() >= MAX_CACHE_ENTRIES) cache.clear(); // простое вытеснение: кэш сбрасывается целиком
+    cache[key] = value;
+}
+
+void FilterDesign::clearCache() {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    g_firCache.clear();
+    g_iirCache.clear();
+}
+
+size_t FilterDesign::cacheSize() {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    return g_firCache.size() + g_iirCache.size();
+}
+
+// ===== Общие проверки =====
+
+static void checkFrequencies(BandType band, double f1, double f2) {
+    if (!(f1 > 0.0 && f1 < 1.0))
+        throw std::invalid_argument("Cutoff frequency must be in (0, 1) (normalized to Nyquist)");
+    if (band == BandType::BandPass || band == BandType::BandStop) {
+        if (!(f2 > f1 && f2 < 1.0))
+            throw std::invalid_argument("Band edges must satisfy 0 < f1 < f2 < 1");
+    }
+}
+
+std::vector<double> FilterDesign::toFeedback(const std::vector<double>& a) {
+    if (a.empty() || a[0] == 0.0) throw std::invalid_argument("Leading denominator coefficient must not be zero");
+    std::vector<double> fb(a.size() - 1);
+    for (size_t j = 0; j + 1 < a.size(); ++j)
+        fb[j] = -a[j + 1] / a[0];
+    return fb;
+}
+
+// ===== КИХ: метод окон =====
+
+static double sinc(double x) {
+    if (x == 0.0) return 1.0;
+    return std::sin(PI * x) / (PI * x);
+}
+
+static void checkWindowed(size_t numTaps, BandType band, double f1, double f2, WindowType window, double beta) {
+    if (numTaps == 0) throw std::invalid_argument("Number of taps must be positive");
+    checkFrequencies(band, f1, f2);
+    if (window == WindowType::Kaiser && !std::isfinite(beta)) throw std::invalid_argument("Kaiser beta must be finite");
+}
+
+static std::vector<double> designWindowed(size_t numTaps, BandType band, double f1, double f2, WindowType window, double beta) {
+
+    // полосы пропускания [left, right] в долях частоты Найквиста
+    std::vector<std::pair<double, double>> pass;
+    switch (band) {
+    case BandType::LowPass:  pass.push_back({ 0.0, f1 }); break;
+    case BandType::HighPass: pass.push_back({ f1, 1.0 }); break;
+    case BandType::BandPass: pass.push_back({ f1, f2 }); break;
+    case BandType::BandStop: pass.push_back({ 0.0, f1 }); pass.push_back({ f2, 1.0 }); break;
+    default: throw std::invalid_argument("Unknown band type");
+    }
+
+    // полоса, включающая частоту Найквиста, требует нечетного числа коэффициентов (тип I)
+    if (pass.back().second == 1.0 && numTaps % 2 == 0)
+        throw std::invalid_argument("A filter with a passband at Nyquist requires an odd number of taps");
+
+    double alpha = 0.5 * static_cast<double>(numTaps - 1);
+    std::vector<double> w = Window::generate(window, numTaps, beta, false);
+    std::vector<double> h(numTaps, 0.0);
+    for (size_t n = 0; n < numTaps; ++n) {
+        double m = static_cast<double>(n) - alpha;
+        double v = 0.0;
+        for (const auto& p : pass)
+            v += p.second * sinc(p.second * m) - p.first * sinc(p.first * m);
+        h[n] = v * w[n];
+    }
+
+    // нормировка: единичное усиление на 0, на Найквисте или в центре первой полосы
+    const auto& first = pass.front();
+    double fs = (first.first == 0.0) ? 0.0 : (first.second == 1.0 ? 1.0 : 0.5 * (first.first + first.second));
+    double s = 0.0;
+    for (size_t n = 0; n < numTaps; ++n)
+        s += h[n] * std::cos(PI * (static_cast<double>(n) - alpha) * fs);
+    for (double& x : h) x /= s;
+    return h;
+}
+
+std::vector<double> FilterDesign::firWindowed(size_t numTaps, BandType band, double f1, double f2, WindowType window, double beta) {
+    if (band == BandType::LowPass || band == BandType::HighPass) f2 = 0.0;
+    if (window != WindowType::Kaiser) beta = 0.0;
+    // проверка до поиска в кэше: NaN в ключе std::map сравнивается как «равный» любому числу
+    checkWindowed(numTaps, band, f1, f2, window, beta);
+    SpecKey key = { 0.0, static_cast<double>(numTaps), static_cast<double>(band), f1, f2,
+        static_cast<double>(window), beta };
+
+    auto cached = cacheLookup(g_firCache, key);
+    if (cached) return *cached;
+
+    auto h = std::make_shared<const std::vector<double>>(designWindowed(numTaps, band, f1, f2, window, beta));
+    cacheStore(g_firCache, key, h);
+    return *h;
+}
+
+// ===== КИХ: алгоритм Паркса–Макклеллана =====
+
+// Однократный обмен: глобальный максимум ошибки E заменяет соседний узел того же знака
+// (за крайними узлами — со сдвигом множества). Медленнее многоточечного, но |delta| растет всегда
+static std::vector<size_t> singleExchange(std::vector<size_t> ext, const std::vector<double>& E) {
+    size_t k = 0;
+    for (size_t i = 1; i < E.size(); ++i)
+        if (std::abs(E[i]) > std::abs(E[k])) k = i;
+    const bool positive = E[k] > 0.0;
+    auto same = [&](size_t node) { return (E[node] > 0.0) == positive; };
+    size_t p = std::lower_bound(ext.begin(), ext.end(), k) - ext.begin();
+    if (p < ext.size() && ext[p] == k) return ext;
+    if (p == 0) {
+        if (!same(ext.front())) {
+            ext.pop_back();
+            ext.insert(ext.begin(), k);
+        }
+        else {
+            ext.front() = k;
+        }
+    }
+    else if (p == ext.size()) {
+        if (!same(ext.back())) {
+            ext.erase(ext.begin());
+            ext.push_back(k);
+        }
+        else {
+            ext.back() = k;
+        }
+    }
+    else {
+        ext[same(ext[p - 1]) ? p - 1 : p] = k;
+    }
+    return ext;
+}
+
+/*
+ * Обменный алгоритм Ремеза для фильтра из N коэффициентов. extremal — частоты начального
+ * экстремального множества (пустой вектор — равномерно по сетке); на выходе — частоты
+ * итогового множества. Возвращает коэффициенты; если равноволновое решение не найдено,
+ * выбрасывает std::runtime_error.
+ */
+static std::vector<double> remezExchange(size_t N, const std::vector<double>& bands,
+    const std::vector<double>& desired, const std::vector<double>& weights, std::vector<double>& extremal) {
+    const size_t nBands = bands.size() / 2;
+    const bool odd = (N % 2) == 1;         // тип I (нечетная длина) или тип II (четная)
+    const size_t r = odd ? (N + 1) / 2 : N / 2; // число косинусных членов
+    const double M = 0.5 * static_cast<double>(N - 1);
+
+    // плотная сетка: равномерные точки w = pi*k/K (около 16 на экстремум), значения A(w)
+    // в которых дает одно БПФ длины 2K, и границы полос, где A вычисляется напрямую;
+    // для типа II A(w) = cos(w/2) * P(w) и w = pi исключается
+    size_t K = 1;
+    while (K < 8 * N) K <<= 1;
+    const double dw = PI / static_cast<double>(K);
+    const size_t EDGE = static_cast<size_t>(-1);
+
+    std::vector<double> gw, gs, gh, gd, gwt; // частота, sin(w/2), cos(w/2), желаемое значение и вес
+    std::vector<size_t> gbin;             // номер отсчета БПФ (EDGE — граница полосы)
+    std::vector<char> edgeLo, edgeHi;
+    auto addPoint = [&](double w, size_t b, size_t bin, bool lo, bool hi) {
+        gw.push_back(w);
+        gs.push_back(std::sin(0.5 * w));
+        gh.push_back(std::cos(0.5 * w));
+        gd.push_back(desired[b]);
+        gwt.push_back(weights.empty() ? 1.0 : weights[b]);
+        gbin.push_back(bin);
+        edgeLo.push_back(lo);
+        edgeHi.push_back(hi);
+    };
+    for (size_t b = 0; b < nBands; ++b) {
+        double lo = bands[2 * b] * PI;
+        double hi = bands[2 * b + 1] * PI;
+        if (!odd && hi > PI - dw) hi = PI - dw;
+        if (hi < lo) continue;
+        addPoint(lo, b, EDGE, true, hi == lo);
+        if (hi == lo) continue;
+        // точки ближе dw/4 к границе пропускаются: почти совпадающие узлы портят интерполяцию
+        for (size_t k = static_cast<size_t>(std::ceil((lo + 0.25 * dw) / dw)); k * dw < hi - 0.25 * dw; ++k)
+            addPoint(k * dw, b, k, false, false);
+        addPoint(hi, b, EDGE, false, true);
+    }
+
+    const size_t ng = gw.size();
+    if (ng < r + 1) throw std::invalid_argument("Bands are too narrow for the requested number of taps");
+
+    // множитель типа II и фазовый множитель exp(j*w*M) отсчетов БПФ
+    std::vector<double> gc(ng, 1.0);
+    std::vector<cplx> gphase(ng);
+    double wmax = 0.0;
+    for (size_t k = 0; k < ng; ++k) {
+        if (!odd) gc[k] = gh[k];
+        gphase[k] = std::polar(1.0, gw[k] * M);
+        wmax = std::max(wmax, gwt[k]);
+    }
+
+    // начальное множество: ближайшие точки сетки к заданным частотам (строго по возрастанию)
+    // или равномерно по сетке
+    std::vector<size_t> ext(r + 1);
+    for (size_t i = 0; i <= r; ++i) {
+        if (extremal.size() == r + 1) {
+            size_t k = std::lower_bound(gw.begin(), gw.end(), extremal[i]) - gw.begin();
+            if (k == ng || (k > 0 && extremal[i] - gw[k - 1] < gw[k] - extremal[i])) --k;
+            ext[i] = k;
+        }
+        else {
+            ext[i] = i * (ng - 1) / r;
+        }
+    }
+    for (size_t i = 1; i <= r; ++i) ext[i] = std::max(ext[i], ext[i - 1] + 1);
+    ext[r] = std::min(ext[r], ng - 1);
+    for (size_t i = r; i-- > 0;) ext[i] = std::min(ext[i], ext[i + 1] - 1);
+
+    std::vector<double> S(r + 1), Ch(r + 1), gamma(r + 1), logs(r + 1), C(r), bw(r), E(ng), h(N);
+    std::vector<cplx> H(N), dense(2 * K);
+    auto plan = FFTPlan::get(N);
+    auto densePlan = FFTPlan::get(2 * K);
+
+    // разность cos(a) - cos(b) = -2 sin((a+b)/2) sin((a-b)/2) по синусам и косинусам
+    // половинных углов: прямое вычитание косинусов около w = 0 и w = pi теряет разряды,
+    // и барицентрические веса перестают задавать многочлен
+    auto cosDiff = [](double sa, double ca, double sb, double cb) {
+        return -2.0 * (sa * cb + ca * sb) * (sa * cb - ca * sb);
+    };
+
+    // интерполянт P(x), x = cos(w), проходящий через узлы ext[i] со значениями C[i], i < r;
+    // аргументы — sin(w/2) и cos(w/2)
+    auto evalP = [&](double sw, double cw) {
+        double num = 0.0, den = 0.0;
+        for (size_t i = 0; i < r; ++i) {
+            double d = cosDiff(sw, cw, S[i], Ch[i]);
+            if (d == 0.0) return C[i];
+            double t = bw[i] / d;
+            num += t * C[i];
+            den += t;
+        }
+        return num / den;
+    };
+
+    const int MAX_ITERATIONS = 100;
+    const int MAX_INEXACT = 20;    // итераций подряд, когда БПФ не дает нужной точности
+    const double TOLERANCE = 1e-6; // допустимое превышение максимума ошибки над |delta|
+    const double STALLED_TOLERANCE = 1e-2; // то же, когда обмен больше не увеличивает |delta|
+    int inexact = 0;
+    // предыдущее множество узлов и ошибка на нем — для отката обмена
+    std::vector<size_t> prevExt;
+    std::vector<double> prevE;
+    double prevDelta = 0.0;
+    bool rolledBack = false;
+    for (int iter = 0; iter < MAX_ITERATIONS; ++iter) {
+        // барицентрические веса узлов; произведения ведутся с отдельным
+        // двоичным порядком, чтобы не было переполнения при тысячах узлов
+        for (size_t i = 0; i <= r; ++i) {
+            S[i] = gs[ext[i]];
+            Ch[i] = gh[ext[i]];
+        }
+        double lmin = 0.0;
+        for (size_t i = 0; i <= r; ++i) {
+            double prod = 1.0;
+            int exponent = 0;
+            for (size_t j = 0; j <= r; ++j) {
+                if (j == i) continue;
+                prod *= 2.0 * cosDiff(S[i], Ch[i], S[j], Ch[j]);
+                if (std::abs(prod) > 1e100 || std::abs(prod) < 1e-100) {
+                    int e = 0;
+                    prod = std::frexp(prod, &e);
+                    exponent += e;
+                }
+            }
+            gamma[i] = prod < 0.0 ? -1.0 : 1.0;
+            logs[i] = std::log(std::abs(prod)) + exponent * std::log(2.0);
+            if (i == 0 || logs[i] < lmin) lmin = logs[i];
+        }
+        for (size_t i = 0; i <= r; ++i)
+            gamma[i] *= std::exp(-(logs[i] - lmin));
+
+        // уровень чередующейся ошибки delta; для типа II задача решается для P(w)
+        // с желаемым значением D/c и весом W*c
+        double num = 0.0, den = 0.0;
+        for (size_t i = 0; i <= r; ++i) {
+            double sgn = (i % 2 == 0) ? 1.0 : -1.0;
+            num += gamma[i] * gd[ext[i]] / gc[ext[i]];
+            den += sgn * gamma[i] / (gwt[ext[i]] * gc[ext[i]]);
+        }
+        const double delta = num / den;
+        if (!std::isfinite(delta)) break;
+        // |delta| не убывает от итерации к итерации (теорема Валле-Пуссена). Если
+        // многоточечный обмен это нарушил, он откатывается и заменяется
+        // однократным: в множество входит только глобальный максимум ошибки
+        if (!prevExt.empty() && std::abs(delta) < prevDelta * (1.0 - 1e-9)) {
+            if (rolledBack) break;
+            ext = singleExchange(prevExt, prevE);
+            rolledBack = true;
+            continue;
+        }
+        rolledBack = false;
+        for (size_t i = 0; i < r; ++i) {
+            double sgn = (i % 2 == 0) ? 1.0 : -1.0;
+            C[i] = (gd[ext[i]] - sgn * delta / gwt[ext[i]]) / gc[ext[i]];
+            bw[i] = gamma[i] * 2.0 * cosDiff(S[i], Ch[i], S[r], Ch[r]); // веса для узлов без последнего
+        }
+
+        // коэффициенты: H[m] = A(w_m) * exp(-j*w_m*(N-1)/2), h = ОБПФ(H)
+        for (size_t m = 0; m <= N / 2; ++m) {
+            double w = 2.0 * PI * static_cast<double>(m) / static_cast<double>(N);
+            double A = evalP(std::sin(0.5 * w), std::cos(0.5 * w));
+            if (!odd) A *= std::cos(0.5 * w);
+            H[m] = std::polar(A, -w * M);
+            if (m > 0 && m < N - m) H[N - m] = std::conj(H[m]);
+        }
+        plan->inverse(H.data());
+        for (size_t n = 0; n < N; ++n) h[n] = H[n].real();
+        // точная симметрия
+        for (size_t n = 0; n < N / 2; ++n) {
+            double v = 0.5 * (h[n] + h[N - 1 - n]);
+            h[n] = v;
+            h[N - 1 - n] = v;
+        }
+
+        // ошибка E = W * (D - A) на сетке: A(w) — из БПФ коэффициентов, дополненных нулями
+        // (на границах полос — интерполянтом). Погрешность БПФ — порядка eps * Σ|h|; пока
+        // интерполянт далек от решения и велик в переходных полосах, она сравнима с delta
+        std::fill(dense.begin(), dense.end(), cplx(0.0, 0.0));
+        double hsum = 0.0;
+        for (size_t n = 0; n < N; ++n) {
+            dense[n] = h[n];
+            hsum += std::abs(h[n]);
+        }
+        densePlan->forward(dense.data());
+        double maxErr = 0.0;
+        for (size_t k = 0; k < ng; ++k) {
+            double A = gbin[k] != EDGE ? (dense[gbin[k]] * gphase[k]).real() : evalP(gs[k], gh[k]) * gc[k];
+            E[k] = gwt[k] * (gd[k] - A);
+            maxErr = std::max(maxErr, std::abs(E[k]));
+        }
+        const double noise = 1e3 * std::numeric_limits<double>::epsilon() * wmax * hsum;
+        const bool exact = noise < 1e-3 * std::abs(delta);
+
+        // сходимость: максимум ошибки на сетке достиг уровня чередования. Если точность
+        // не достигается много итераций подряд, оптимальные пульсации лежат за пределом
+        // двойной точности (слишком много коэффициентов для переходных полос)
+        if (exact) {
+            inexact = 0;
+            // при пульсациях около 1e-8 и меньше |delta| перестает расти раньше, чем
+            // достигается TOLERANCE: дальше мешает округление, а не алгоритм
+            const bool stalled = !prevExt.empty() && std::abs(delta) <= prevDelta * (1.0 + 1e-4);
+            const double tolerance = stalled ? STALLED_TOLERANCE : TOLERANCE;
+            if (maxErr - std::abs(delta) <= tolerance * maxErr) {
+                extremal.resize(r + 1);
+                for (size_t i = 0; i <= r; ++i) extremal[i] = gw[ext[i]];
+                return h;
+            }
+        }
+        else if (++inexact > MAX_INEXACT) {
+            throw std::runtime_error("Parks-McClellan design failed to converge: ripple is below double precision");
+        }
+
+        // в узлах ошибка равна ±delta точно: так знаки узлов чередуются всегда
+        for (size_t i = 0; i <= r; ++i)
+            E[ext[i]] = (i % 2 == 0) ? delta : -delta;
+        prevExt = ext;
+        prevE = E;
+        prevDelta = std::abs(delta);
+
+        // кандидаты: текущие узлы и локальные экстремумы ошибки не меньше |delta|
+        // (границы полос — всегда кандидаты); узлы уже чередуются, поэтому
+        // чередующееся множество из r + 1 точек находится всегда
+        std::vector<char> keep(ng, 0);
+        for (size_t k : ext) keep[k] = 2;
+        std::vector<size_t> found;
+        const double threshold = std::abs(delta) + (exact ? 0.0 : noise);
+        for (size_t k = 0; k < ng; ++k) {
+            double e = E[k];
+            if (keep[k] || std::abs(e) < threshold) continue;
+            bool left = edgeLo[k] || (e > 0.0 ? e >= E[k - 1] : e <= E[k - 1]);
+            bool right = edgeHi[k] || (e > 0.0 ? e > E[k + 1] : e < E[k + 1]);
+            if (left && right) found.push_back(k);
+        }
+        // при грубых значениях БПФ найденные экстремумы уточняются интерполянтом
+        // (в точке и у соседей в той же полосе): выбор узлов опирается только на точные значения
+        for (size_t k : found) {
+            size_t best = k;
+            if (!exact) {
+                double bestErr = 0.0;
+                for (size_t j = edgeLo[k] ? k : k - 1; j <= k + 1 && j < ng; ++j) {
+                    if (j > k && edgeHi[k]) break;
+                    if (keep[j] == 2) continue;
+                    double e = gwt[j] * (gd[j] - evalP(gs[j], gh[j]) * gc[j]);
+                    if (std::abs(e) > bestErr) {
+                        bestErr = std::abs(e);
+                        best = j;
+                    }
+                    E[j] = e;
+                }
+                if (bestErr < std::abs(delta)) continue;
+            }
+            keep[best] = 1;
+        }
+
+        // чередование знаков: из подряд идущих экстремумов одного знака остается наибольший
+        std::vector<size_t> alt;
+        for (size_t k = 0; k < ng; ++k) {
+            if (!keep[k]) continue;
+            if (!alt.empty() && (E[k] > 0.0) == (E[alt.back()] > 0.0)) {
+                if (std::abs(E[k]) > std::abs(E[alt.back()])) alt.back() = k;
+            }
+            else {
+                alt.push_back(k);
+            }
+        }
+
+        // лишние экстремумы: наименьший удаляется вместе с меньшим из соседей (чтобы
+        // сохранить чередование), крайний — один; при одном лишнем — меньший из крайних
+        const size_t na = alt.size();
+        std::vector<size_t> prev(na), next(na);
+        std::set<std::pair<double, size_t>> order;
+        for (size_t i = 0; i < na; ++i) {
+            prev[i] = i > 0 ? i - 1 : EDGE;
+            next[i] = i + 1 < na ? i + 1 : EDGE;
+            order.insert({ std::abs(E[alt[i]]), i });
+        }
+        size_t head = 0, tail = na - 1, count = na;
+        auto remove = [&](size_t i) {
+            order.erase({ std::abs(E[alt[i]]), i });
+            if (prev[i] != EDGE) next[prev[i]] = next[i]; else head = next[i];
+            if (next[i] != EDGE) prev[next[i]] = prev[i]; else tail = prev[i];
+            --count;
+        };
+        while (count > r + 1) {
+            size_t i = order.begin()->second;
+            if (count == r + 2) {
+                remove(std::abs(E[alt[head]]) < std::abs(E[alt[tail]]) ? head : tail);
+            }
+            else if (i == head || i == tail) {
+                remove(i);
+            }
+            else {
+                size_t a = prev[i], b = next[i];
+                remove(i);
+                remove(std::abs(E[alt[a]]) < std::abs(E[alt[b]]) ? a : b);
+            }
+        }
+        size_t pos = 0;
+        for (size_t i = head; i != EDGE; i = next[i]) ext[pos++] = alt[i];
+    }
+    throw std::runtime_error("Parks-McClellan design failed to converge");
+}
+
+/*
+ * Начальное множество для длинного фильтра — итоговое множество фильтра вдвое короче
+ * (того же типа), перенесенное по полосам: недостающие точки делятся между полосами
+ * по ширине, положения интерполируются линейно по номеру точки. Равномерное начальное множество
+ * для тысяч коэффициентов дает интерполянт с огромным размахом в переходных полосах,
+ * и обмен теряет точность.
+ */
+static std::vector<double> remezDesign(size_t N, const std::vector<double>& bands,
+    const std::vector<double>& desired, const std::vector<double>& weights, std::vector<double>& extremal) {
+    const size_t r = (N % 2 == 1) ? (N + 1) / 2 : N / 2;
+    extremal.clear();
+    if (r > 128) {
+        size_t shorter = N / 2 + ((N / 2) % 2 != N % 2 ? 1 : 0);
+        std::vector<double> coarse;
+        remezDesign(shorter, bands, desired, weights, coarse);
+
+        const size_t nBands = bands.size() / 2;
+        std::vector<std::vector<double>> perBand(nBands);
+        std::vector<size_t> counts(nBands, 0);
+        for (double w : coarse) {
+            size_t b = 0;
+            while (b + 1 < nBands && w > bands[2 * b + 1] * PI) ++b;
+            if (perBand[b].empty() && w > bands[2 * b] * PI) perBand[b].push_back(bands[2 * b] * PI);
+            perBand[b].push_back(w);
+            ++counts[b];
+        }
+        // границы полос — всегда в множестве: без крайнего узла интерполянт высокой
+        // степени за последним узлом полосы растет экспоненциально
+        for (size_t b = 0; b < nBands; ++b)
+            if (!perBand[b].empty() && perBand[b].back() < bands[2 * b + 1] * PI) perBand[b].push_back(bands[2 * b + 1] * PI);
+
+        // число точек в полосе — постоянная часть (краевые эффекты) плюс часть,
+        // пропорциональная ширине: добавленные точки делятся по ширине полос,
+        // остаток округления — в самую широкую
+        if (!coarse.empty() && coarse.size() < r + 1) {
+            double span = 0.0;
+            size_t widest = 0;
+            for (size_t b = 0; b < nBands; ++b) {
+                span += bands[2 * b + 1] - bands[2 * b];
+                if (bands[2 * b + 1] - bands[2 * b] > bands[2 * widest + 1] - bands[2 * widest]) widest = b;
+            }
+            size_t total = 0;
+            for (size_t b = 0; b < nBands; ++b) {
+                if (counts[b] > 0)
+                    counts[b] += static_cast<size_t>(std::round((r + 1 - coarse.size()) * (bands[2 * b + 1] - bands[2 * b]) / span));
+                total += counts[b];
+            }
+            if (counts[widest] > 0 && counts[widest] + (r + 1) > total) {
+                counts[widest] = counts[widest] + (r + 1) - total;
+                for (size_t b = 0; b < nBands; ++b) {
+                    const std::vector<double>& src = perBand[b];
+                    for (size_t i = 0; i < counts[b]; ++i) {
+                        double t = counts[b] > 1 ? static_cast<double>(i) * (src.size() - 1) / (counts[b] - 1) : 0.0;
+                        size_t j = std::min(static_cast<size_t>(t), src.size() - 1);
+                        extremal.push_back(j + 1 < src.size() ? src[j] + (t - j) * (src[j + 1] - src[j]) : src[j]);
+                    }
+                }
+            }
+        }
+    }
+    return remezExchange(N, bands, desired, weights, extremal);
+}
+
+static void checkRemez(size_t numTaps, const std::vector<double>& bands,
+    const std::vector<double>& desired, const std::vector<double>& weights) {
+    if (numTaps < 3) throw std::invalid_argument("Parks-McClellan design requires at least 3 taps");
+    if (bands.empty() || bands.size() % 2 != 0)
+        throw std::invalid_argument("Band edges must be given in pairs");
+    size_t nBands = bands.size() / 2;
+    if (desired.size() != nBands) throw std::invalid_argument("One desired value per band is required");
+    if (!weights.empty() && weights.size() != nBands) throw std::invalid_argument("One weight per band is required");
+    for (size_t i = 0; i < bands.size(); ++i) {
+        if (!(bands[i] >= 0.0 && bands[i] <= 1.0)) throw std::invalid_argument("Band edges must be in [0, 1]");
+        if (i > 0 && bands[i] < bands[i - 1]) throw std::invalid_argument("Band edges must be non-decreasing");
+    }
+    for (double d : desired)
+        if (!std::isfinite(d)) throw std::invalid_argument("Desired values must be finite");
+    for (double w : weights)
+        if (!(w > 0.0 && std::isfinite(w))) throw std::invalid_argument("Weights must be positive");
+}
+
+static std::vector<double> designRemez(size_t numTaps, const std::vector<double>& bands,
+    const std::vector<double>& desired, const std::vector<double>& weights) {
+    std::vector<double> extremal;
+    return remezDesign(numTaps, bands, desired, weights, extremal);
+}
+
+std::vector<double> FilterDesign::firRemez(size_t numTaps, const std::vector<double>& bands,
+    const std::vector<double>& desired, const std::vector<double>& weights) {
+    checkRemez(numTaps, bands, desired, weights);
+    SpecKey key = { 1.0, static_cast<double>(numTaps), static_cast<double>(bands.size()) };
+    key.insert(key.end(), bands.begin(), bands.end());
+    key.insert(key.end(), desired.begin(), desired.end());
+    key.push_back(static_cast<double>(weights.size()));
+    key.insert(key.end(), weights.begin(), weights.end());
+
+    auto cached = cacheLookup(g_firCache, key);
+    if (cached) return *cached;
+
+    auto h = std::make_shared<const std::vector<double>>(designRemez(numTaps, bands, desired, weights));
+    cacheStore(g_firCache, key, h);
+    return *h;
+}
+
+// ===== БИХ: аналоговые прототипы в форме нулей/полюсов/усиления =====
+
+/** Нули, полюса и коэффициент усиления передаточной функции. */
+struct ZPK {
+    std::vector<cplx> z;
+    std::vector<cplx> p;
+    double k;
+};
+
+static cplx prodNeg(const std::vector<cplx>& v) {
+    cplx r(1.0, 0.0);
+    for (const cplx& x : v) r *= -x;
+    return r;
+}
+
+static ZPK butterPrototype(int n) {
+    ZPK f{ {}, {}, 1.0 };
+    for (int m = -n + 1; m < n; m += 2)
+        f.p.push_back(-std::exp(cplx(0.0, PI * m / (2.0 * n))));
+    return f;
+}
+
+static ZPK cheby1Prototype(int n, double rp) {
+    double eps = std::sqrt(std::pow(10.0, 0.1 * rp) - 1.0);
+    double mu = std::asinh(1.0 / eps) / n;
+    ZPK f{ {}, {}, 1.0 };
+    for (int m = -n + 1; m < n; m += 2) {
+        double theta = PI * m / (2.0 * n);
+        f.p.push_back(-std::sinh(cplx(mu, theta)));
+    }
+    f.k = prodNeg(f.p).real();
+    if (n % 2 == 0) f.k /= std::sqrt(1.0 + eps * eps);
+    return f;
+}
+
+static ZPK cheby2Prototype(int n, double rs) {
+    double de = 1.0 / std::sqrt(std::pow(10.0, 0.1 * rs) - 1.0);
+    double mu = std::asinh(1.0 / de) / n;
+    ZPK f{ {}, {}, 1.0 };
+    for (int m = -n + 1; m < n; m += 2) {
+        if (m == 0) continue; // при нечетном порядке нуль в бесконечности
+        f.z.push_back(-std::conj(cplx(0.0, 1.0) / std::sin(m * PI / (2.0 * n))));
+    }
+    for (int m = -n + 1; m < n; m += 2) {
+        cplx p = -std::exp(cplx(0.0, PI * m / (2.0 * n)));
+        p = cplx(std::sinh(mu) * p.real(), std::cosh(mu) * p.imag());
+        f.p.push_back(1.0 / p);
+    }
+    f.k = (prodNeg(f.p) / prodNeg(f.z)).real();
+    return f;
+}
+
+/*
+ * Эллиптические функции через спуск Ландена
+ * (S. J. Orfanidis, "Lecture Notes on Elliptic Filter Design").
+ */
+static std::vector<double> landen(double k) {
+    std::vector<double> v;
+    while (k > 1e-16 && v.size() < 64) {
+        double kp = std::sqrt(1.0 - k * k);
+        k = (k / (1.0 + kp)) * (k / (1.0 + kp));
+        v.push_back(k);
+    }
+    return v;
+}
+
+static double ellipK(double k) {
+    std::vector<double> v = landen(k);
+    double K = PI / 2.0;
+    for (double x : v) K *= 1.0 + x;
+    return K;
+}
+
+static cplx cde(cplx u, double k) {
+    std::vector<double> v = landen(k);
+    cplx w = std::cos(u * (PI / 2.0));
+    for (size_t n = v.size(); n-- > 0;)
+        w = (1.0 + v[n]) * w / (1.0 + v[n] * w * w);
+    return w;
+}
+
+static cplx sne(cplx u, double k) {
+    std::vector<double> v = landen(k);
+    cplx w = std::sin(u * (PI / 2.0));
+    for (size_t n = v.size(); n-- > 0;)
+        w = (1.0 + v[n]) * w / (1.0 + v[n] * w * w);
+    return w;
+}
+
+static double srem(double x, double y) {
+    return x - y * std::round(x / y);
+}
+
+static cplx acde(cplx w, double k) {
+    std::vector<double> v = landen(k);
+    for (size_t n = 0; n < v.size(); ++n) {
+        double v1 = (n == 0) ? k : v[n - 1];
+        w = w / (1.0 + std::sqrt(1.0 - w * w * (v1 * v1))) * (2.0 / (1.0 + v[n]));
+    }
+    cplx u = std::acos(w) * (2.0 / PI);
+    double R = ellipK(std::sqrt(1.0 - k * k)) / ellipK(k);
+    return cplx(srem(u.real(), 4.0), srem(u.imag(), 2.0 * R));
+}
+
+static cplx asne(cplx w, double k) {
+    return 1.0 - acde(w, k);
+}
+
+// модуль k по порядку N и модулю k1 (уравнение вырождения)
+static double ellipdeg(int n, double k1) {
+    if (k1 < 1e-6) {
+        // разложение через ном q для очень малых k1
+        double K1 = ellipK(k1);
+        double K1p = ellipK(std::sqrt(1.0 - k1 * k1));
+        double q = std::exp(-PI * K1p / K1 / n);
+        double a = 0.0, b = 0.0;
+        for (int m = 0; m <= 7; ++m) b += std::pow(q, m * (m + 1));
+        for (int m = 1; m <= 7; ++m) a += std::pow(q, m * m);
+        a = 1.0 + 2.0 * a;
+        return 4.0 * std::sqrt(q) * (b / a) * (b / a);
+    }
+    double kc = std::sqrt(1.0 - k1 * k1);
+    double prod = 1.0;
+    for (int i = 1; i <= n / 2; ++i)
+        prod *= sne(cplx((2.0 * i - 1.0) / n, 0.0), kc).real();
+    double kp = std::pow(kc, n) * std::pow(prod, 4);
+    return std::sqrt(1.0 - kp * kp);
+}
+
+static ZPK ellipPrototype(int n, double rp, double rs) {
+    double ep = std::sqrt(std::pow(10.0, 0.1 * rp) - 1.0);
+    double es = std::sqrt(std::pow(10.0, 0.1 * rs) - 1.0);
+    double k1 = ep / es;
+    double k = ellipdeg(n, k1);
+    const cplx j(0.0, 1.0);
+
+    double v0 = (-j * asne(j / ep, k1) / static_cast<double>(n)).real();
+
+    ZPK f{ {}, {}, 1.0 };
+    for (int i = 1; i <= n / 2; ++i) {
+        double ui = (2.0 * i - 1.0) / n;
+        double zeta = cde(cplx(ui, 0.0), k).real();
+        cplx z = j / (k * zeta);
+        f.z.push_back(z);
+        f.z.push_back(std::conj(z));
+
+        cplx p = j * cde(cplx(ui, -v0), k);
+        f.p.push_back(p);
+        f.p.push_back(std::conj(p));
+    }
+    if (n % 2 == 1)
+        f.p.push_back(cplx((j * sne(j * v0, k)).real(), 0.0));
+
+    double h0 = (n % 2 == 1) ? 1.0 : 1.0 / std::sqrt(1.0 + ep * ep);
+    f.k = h0 * (prodNeg(f.p) / prodNeg(f.z)).real();
+    return f;
+}
+
+// ===== Частотные преобразования и билинейное отображение =====
+
+static ZPK lp2lp(const ZPK& f, double wo) {
+    ZPK r = f;
+    for (cplx& z : r.z) z *= wo;
+    for (cplx& p : r.p) p *= wo;
+    r.k = f.k * std::pow(wo, static_cast<double>(f.p.size() - f.z.size()));
+    return r;
+}
+
+static ZPK lp2hp(const ZPK& f, double wo) {
+    ZPK r{ {}, {}, 0.0 };
+    for (const cplx& z : f.z) r.z.push_back(wo / z);
+    for (const cplx& p : f.p) r.p.push_back(wo / p);
+    for (size_t i = f.z.size(); i < f.p.size(); ++i) r.z.push_back(cplx(0.0, 0.0));
+    r.k = f.k * (prodNeg(f.z) / prodNeg(f.p)).real();
+    return r;
+}
+
+static ZPK lp2bp(const ZPK& f, double wo, double bw) {
+    ZPK r{ {}, {}, 0.0 };
+    for (const cplx& z : f.z) {
+        cplx zl = z * (bw / 2.0);
+        cplx s = std::sqrt(zl * zl - wo * wo);
+        r.z.push_back(zl + s);
+        r.z.push_back(zl - s);
+    }
+    for (const cplx& p : f.p) {
+        cplx pl = p * (bw / 2.0);
+        cplx s = std::sqrt(pl * pl - wo * wo);
+        r.p.push_back(pl + s);
+        r.p.push_back(pl - s);
+    }
+    size_t degree = f.p.size() - f.z.size();
+    for (size_t i = 0; i < degree; ++i) r.z.push_back(cplx(0.0, 0.0));
+    r.k = f.k * std::pow(bw, static_cast<double>(degree));
+    return r;
+}
+
+static ZPK lp2bs(const ZPK& f, double wo, double bw) {
+    ZPK r{ {}, {}, 0.0 };
+    for (const cplx& z : f.z) {
+        cplx zh = (bw / 2.0) / z;
+        cplx s = std::sqrt(zh * zh - wo * wo);
+        r.z.push_back(zh + s);
+        r.z.push_back(zh - s);
+    }
+    for (const cplx& p : f.p) {
+        cplx ph = (bw / 2.0) / p;
+        cplx s = std::sqrt(ph * ph - wo * wo);
+        r.p.push_back(ph + s);
+        r.p.push_back(ph - s);
+    }
+    size_t degree = f.p.size() - f.z.size();
+    for (size_t i = 0; i < degree; ++i) {
+        r.z.push_back(cplx(0.0, wo));
+        r.z.push_back(cplx(0.0, -wo));
+    }
+    r.k = f.k * (prodNeg(f.z) / prodNeg(f.p)).real();
+    return r;
+}
+
+static ZPK bilinear(const ZPK& f, double fs) {
+    double fs2 = 2.0 * fs;
+    ZPK r{ {}, {}, 0.0 };
+    cplx num(1.0, 0.0), den(1.0, 0.0);
+    for (const cplx& z : f.z) {
+        r.z.push_back((fs2 + z) / (fs2 - z));
+        num *= fs2 - z;
+    }
+    for (const cplx& p : f.p) {
+        r.p.push_back((fs2 + p) / (fs2 - p));
+        den *= fs2 - p;
+    }
+    for (size_t i = f.z.size(); i < f.p.size(); ++i) r.z.push_back(cplx(-1.0, 0.0));
+    r.k = f.k * (num / den).real();
+    return r;
+}
+
+// ===== Переход от нулей/полюсов к коэффициентам =====
+
+static std::vector<double> polyFromRoots(const std::vector<cplx>& roots) {
+    std::vector<cplx> c(1, cplx(1.0, 0.0));
+    for (const cplx& r : roots) {
+        c.push_back(cplx(0.0, 0.0));
+        for (size_t i = c.size() - 1; i > 0; --i)
+            c[i] -= r * c[i - 1];
+    }
+    std::vector<double> out(c.size());
+    for (size_t i = 0; i < c.size(); ++i) out[i] = c[i].real();
+    return out;
+}
+
+/*
+ * Разбиение корней на группы для биквадратных секций:
+ * комплексно-сопряженные пары — по одной группе, вещественные корни — парами.
+ */
+static const double CONJ_TOL = 1e-10;
+
+static void splitRoots(const std::vector<cplx>& roots, std::vector<cplx>& pairs, std::vector<double>& reals) {
+    for (const cplx& r : roots) {
+        if (std::abs(r.imag()) <= CONJ_TOL * std::max(1.0, std::abs(r))) reals.push_back(r.real());
+        else if (r.imag() > 0.0) pairs.push_back(r);
+    }
+}
+
+static std::vector<std::array<double, 6>> zpkToSos(const ZPK& f) {
+    std::vector<cplx> pPairs, zPairs;
+    std::vector<double> pReals, zReals;
+    splitRoots(f.p, pPairs, pReals);
+    splitRoots(f.z, zPairs, zReals);
+
+    // группы полюсов
+    std::vector<std::vector<cplx>> groups;
+    std::sort(pReals.begin(), pReals.end(), [](double x, double y) { return std::abs(x) > std::abs(y); });
+    if (pReals.size() % 2 == 1) {
+        // одиночный вещественный полюс идет первым, чтобы ему достался вещественный нуль
+        groups.push_back({ cplx(pReals.back(), 0.0) });
+        pReals.pop_back();
+    }
+    std::vector<std::vector<cplx>> rest;
+    for (const cplx& p : pPairs) rest.push_back({ p, std::conj(p) });
+    for (size_t i = 0; i + 1 < pReals.size(); i += 2)
+        rest.push_back({ cplx(pReals[i], 0.0), cplx(pReals[i + 1], 0.0) });
+    // полюса, ближайшие к единичной окружности, обрабатываются раньше и получают ближайшие нули
+    std::sort(rest.begin(), rest.end(), [](const std::vector<cplx>& a, const std::vector<cplx>& b) {
+        return std::abs(1.0 - std::abs(a[0])) < std::abs(1.0 - std::abs(b[0]));
+    });
+    groups.insert(groups.end(), rest.begin(), rest.end());
+
+    std::vector<std::vector<cplx>> zgroups(groups.size());
+    for (size_t g = 0; g < groups.size(); ++g) {
+        const cplx p = groups[g][0];
+        if (groups[g].size() == 1) {
+            if (!zReals.empty()) {
+                auto it = std::min_element(zReals.begin(), zReals.end(),
+                    [&](double x, double y) { return std::abs(p - x) < std::abs(p - y); });
+                zgroups[g].push_back(cplx(*it, 0.0));
+                zReals.erase(it);
+            }
+            continue;
+        }
+
+        double bestPair = 1e300, bestReal = 1e300;
+        size_t ip = 0;
+        for (size_t i = 0; i < zPairs.size(); ++i) {
+            double d = std::min(std::abs(p - zPairs[i]), std::abs(p - std::conj(zPairs[i])));
+            if (d < bestPair) { bestPair = d; ip = i; }
+        }
+        if (zReals.size() >= 2) {
+            for (double x : zReals) bestReal = std::min(bestReal, std::abs(p - x));
+        }
+
+        if (!zPairs.empty() && bestPair <= bestReal) {
+            zgroups[g] = { zPairs[ip], std::conj(zPairs[ip]) };
+            zPairs.erase(zPairs.begin() + ip);
+        }
+        else {
+            for (int t = 0; t < 2 && !zReals.empty(); ++t) {
+                auto it = std::min_element(zReals.begin(), zReals.end(),
+                    [&](double x, double y) { return std::abs(p - x) < std::abs(p - y); });
+                zgroups[g].push_back(cplx(*it, 0.0));
+                zReals.erase(it);
+            }
+        }
+    }
+
+    // оставшиеся нули раскладываются по свободным местам секций
+    for (size_t g = 0; g < groups.size(); ++g) {
+        if (zgroups[g].empty() && groups[g].size() == 2 && !zPairs.empty()) {
+            zgroups[g] = { zPairs.back(), std::conj(zPairs.back()) };
+            zPairs.pop_back();
+        }
+        while (zgroups[g].size() < 2 && !zReals.empty()) {
+            zgroups[g].push_back(cplx(zReals.back(), 0.0));
+            zReals.pop_back();
+        }
+    }
+
+    // секции с полюсами ближе к единичной окружности ставятся в конец каскада
+    std::vector<std::array<double, 6>> sos;
+    for (size_t g = groups.size(); g-- > 0;) {
+        std::vector<double> b = polyFromRoots(zgroups[g]);
+        std::vector<double> a = polyFromRoots(groups[g]);
+        b.resize(3, 0.0);
+        a.resize(3, 0.0);
+        sos.push_back({ b[0], b[1], b[2], a[0], a[1], a[2] });
+    }
+    if (!sos.empty()) {
+        for (int i = 0; i < 3; ++i) sos[0][i] *= f.k;
+    }
+    return sos;
+}
+
+static void checkIIR(int order, BandType band, double f1, double f2, IIRPrototype prototype, double rp, double rs) {
+    if (order <= 0 || order > 64) throw std::invalid_argument("Filter order must be in [1, 64]");
+    checkFrequencies(band, f1, f2);
+    if ((prototype == IIRPrototype::Chebyshev1 || prototype == IIRPrototype::Elliptic) && !(rp > 0.0 && std::isfinite(rp)))
+        throw std::invalid_argument("Passband ripple must be positive and finite");
+    if ((prototype == IIRPrototype::Chebyshev2 || prototype == IIRPrototype::Elliptic) && !(rs > 0.0 && std::isfinite(rs)))
+        throw std::invalid_argument("Stopband attenuation must be positive and finite");
+    if (prototype == IIRPrototype::Elliptic && !(rs > rp))
+        throw std::invalid_argument("Stopband attenuation must exceed passband ripple");
+}
+
+static IIRDesign designIIR(int order, BandType band, double f1, double f2, IIRPrototype prototype, double rp, double rs) {
+    ZPK proto;
+    switch (prototype) {
+    case IIRPrototype::Butterworth: proto = butterPrototype(order); break;
+    case IIRPrototype::Chebyshev1:  proto = cheby1Prototype(order, rp); break;
+    case IIRPrototype::Chebyshev2:  proto = cheby2Prototype(order, rs); break;
+    case IIRPrototype::Elliptic:    proto = ellipPrototype(order, rp, rs); break;
+    default: throw std::invalid_argument("Unknown IIR prototype");
+    }
+
+    // предыскажение частот для билинейного преобразования (fs = 2, частота Найквиста = 1)
+    const double fs = 2.0;
+    double w1 = 2.0 * fs * std::tan(PI * f1 / fs);
+    double w2 = 2.0 * fs * std::tan(PI * f2 / fs);
+
+    ZPK analog;
+    switch (band) {
+    case BandType::LowPass:  analog = lp2lp(proto, w1); break;
+    case BandType::HighPass: analog = lp2hp(proto, w1); break;
+    case BandType::BandPass: analog = lp2bp(proto, std::sqrt(w1 * w2), w2 - w1); break;
+    case BandType::BandStop: analog = lp2bs(proto, std::sqrt(w1 * w2), w2 - w1); break;
+    default: throw std::invalid_argument("Unknown band type");
+    }
+
+    ZPK digital = bilinear(analog, fs);
+
+    IIRDesign d;
+    d.tf.b = polyFromRoots(digital.z);
+    for (double& x : d.tf.b) x *= digital.k;
+    d.tf.a = polyFromRoots(digital.p);
+    d.sos = zpkToSos(digital);
+    return d;
+}
+
+IIRDesign FilterDesign::iir(int order, BandType band, double f1, double f2, IIRPrototype prototype, double rp, double rs) {
+    if (band == BandType::LowPass || band == BandType::HighPass) f2 = 0.0;
+    if (prototype == IIRPrototype::Butterworth) { rp = 0.0; rs = 0.0; }
+    if (prototype == IIRPrototype::Chebyshev1) rs = 0.0;
+    if (prototype == IIRPrototype::Chebyshev2) rp = 0.0;
+    checkIIR(order, band, f1, f2, prototype, rp, rs);
+    SpecKey key = { 2.0, static_cast<double>(order), static_cast<double>(band), f1, f2,
+        static_cast<double>(prototype), rp, rs };
+
+    auto cached = cacheLookup(g_iirCache, key);
+    if (cached) return *cached;
+
+    auto d = std::make_shared<const IIRDesign>(designIIR(order, band, f1, f2, prototype, rp, rs));
+    cacheStore(g_iirCache, key, d);
+    return *d;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "TransferFunction.h"
+#include "Window.h"
+
+/**
+ * @brief Тип полосы пропускания проектируемого фильтра.
+ */
+enum class BandType {
+    LowPass = 0,  /**< Фильтр нижних частот (используется f1) */
+    HighPass = 1, /**< Фильтр верхних частот (используется f1) */
+    BandPass = 2, /**< Полосовой фильтр (полоса f1 ... f2) */
+    BandStop = 3  /**< Режекторный фильтр (полоса f1 ... f2) */
+};
+
+/**
+ * @brief Аналоговый прототип БИХ-фильтра.
+ */
+enum class IIRPrototype {
+    Butterworth = 0, /**< Максимально плоская АЧХ */
+    Chebyshev1 = 1,  /**< Равноволновые пульсации в полосе пропускания (rp) */
+    Chebyshev2 = 2,  /**< Равноволновые пульсации в полосе задерживания (rs) */
+    Elliptic = 3     /**< Пульсации в обеих полосах (rp и rs) */
+};
+
+/**
+ * @brief Результат проектирования БИХ-фильтра.
+ * @details Коэффициенты даны в стандартной форме H(z) = B(z) / A(z), a[0] = 1.
+ * Каждая строка sos — биквадратная секция [b0, b1, b2, a0, a1, a2] с a0 = 1.
+ * Для передачи в IIRFilter / addIIR знаменатель переводится в коэффициенты
+ * обратной связи: a_iir[j] = -a[j+1] (см. FilterDesign::toFeedback).
+ */
+struct IIRDesign {
+    TransferFunction tf;                    /**< Передаточная функция целиком */
+    std::vector<std::array<double, 6>> sos; /**< Каскад биквадратных секций */
+};
+
+/**
+ * @brief Модуль проектирования цифровых фильтров.
+ * @details Все частоты нормированы к частоте Найквиста: 0 < f < 1 (1 соответствует fs/2).
+ * Результаты проектирования кэшируются по полной спецификации, поэтому повторный запрос
+ * с теми же параметрами не выполняет вычислений. Кэш потокобезопасен.
+ */
+class FilterDesign {
+public:
+    /**
+     * @brief Проектирование КИХ-фильтра методом окон (windowed-sinc).
+     * @details Идеальная импульсная характеристика умножается на окно и нормируется
+     * так, чтобы усиление в центре полосы пропускания было равно 1.
+     * @param numTaps Количество коэффициентов. Для HighPass и BandStop должно быть нечетным.
+     * @param band Тип полосы.
+     * @param f1 Частота среза (нижняя граница для BandPass/BandStop).
+     * @param f2 Верхняя граница полосы (для LowPass/HighPass игнорируется).
+     * @param window Тип окна.
+     * @param beta Параметр окна Кайзера.
+     * @return Коэффициенты фильтра b[0] ... b[numTaps-1] (пригодны для FIRFilter).
+     * @throw std::invalid_argument При некорректной спецификации.
+     */
+    static std::vector<double> firWindowed(size_t numTaps, BandType band, double f1, double f2,
+        WindowType window = WindowType::Hamming, double beta = 8.6);
+
+    /**
+     * @brief Проектирование равноволнового КИХ-фильтра алгоритмом Паркса–Макклеллана.
+     * @details Обменный алгоритм Ремеза на плотной сетке частот; интерполяция ведется
+     * в барицентрической форме Лагранжа. Поддерживаются фильтры типа I (нечетное число
+     * коэффициентов) и типа II (четное; желаемое значение на частоте Найквиста должно быть 0).
+     * @param numTaps Количество коэффициентов.
+     * @param bands Границы полос парами [f_lo, f_hi, ...] по возрастанию, в диапазоне [0, 1].
+     * @param desired Желаемое усиление в каждой полосе (bands.size() / 2 значений).
+     * @param weights Веса ошибки в каждой полосе (пустой вектор — все веса равны 1).
+     * @return Симметричные коэффициенты фильтра.
+     * @throw std::invalid_argument При некорректной спецификации.
+     * @throw std::runtime_error Если обменный алгоритм не сошелся к равноволновому решению,
+     *        в том числе когда оптимальные пульсации меньше точности double.
+     */
+    static std::vector<double> firRemez(size_t numTaps, const std::vector<double>& bands,
+        const std::vector<double>& desired, const std::vector<double>& weights = {});
+
+    /**
+     * @brief Проектирование БИХ-фильтра по аналоговому прототипу.
+     * @details Прототип строится в форме нулей/полюсов/усиления, переносится в нужную полосу
+     * частотным преобразованием с предыскажением частот и отображается в z-плоскость
+     * билинейным преобразованием. Для BandPass/BandStop порядок результата равен 2*order.
+     * @param order Порядок прототипа (больше нуля).
+     * @param band Тип полосы.
+     * @param f1 Частота среза (нижняя граница для BandPass/BandStop).
+     * @param f2 Верхняя граница полосы (для LowPass/HighPass игнорируется).
+     * @param prototype Тип прототипа.
+     * @param rp Пульсации в полосе пропускания, дБ (Chebyshev1, Elliptic).
+     * @param rs Затухание в полосе задерживания, дБ (Chebyshev2, Elliptic).
+     * @return Передаточная функция и каскад биквадратных секций.
+     * @throw std::invalid_argument При некорректной спецификации.
+     */
+    static IIRDesign iir(int order, BandType band, double f1, double f2,
+        IIRPrototype prototype = IIRPrototype::Butterworth, double rp = 1.0, double rs = 40.0);
+
+    /**
+     * @brief Перевод знаменателя A(z) (a[0] = 1) в коэффициенты обратной связи IIRFilter.
+     * @param a Знаменатель в стандартной форме.
+     * @return Коэффициенты a_iir[j] = -a[j+1] / a[0].
+     */
+    static std::vector<double> toFeedback(const std::vector<double>& a);
+
+    /**
+     * @brief Очистить кэш спроектированных фильтров.
+     */
+    static void clearCache();
+
+    /**
+     * @brief Количество спецификаций, хранящихся в кэше.
+     * @return Число записей кэша.
+     */
+    static size_t cacheSize();
+};
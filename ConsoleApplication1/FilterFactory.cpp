@@ -0,0 +1,42 @@
+#include "FixedFilters.h"
+#include "FIRFilter.h"
+#include "IIRFilter.h"
+
+// выбор FixedFIR<N> по размеру, известному только во время выполнения
+template <size_t N>
+static std::unique_ptr<Block> makeFixedFIR(const std::string& name, const std::vector<double>& b) {
+    if constexpr (N == 0) {
+        return nullptr;
+    }
+    else {
+        if (b.size() == N) return std::make_unique<FixedFIR<N>>(name, b);
+        return makeFixedFIR<N - 1>(name, b);
+    }
+}
+
+template <size_t NB, size_t NA>
+static std::unique_ptr<Block> makeFixedIIR(const std::string& name, const std::vector<double>& b, const std::vector<double>& a) {
+    if (b.size() == NB && a.size() == NA) return std::make_unique<FixedIIR<NB, NA>>(name, b, a);
+    if constexpr (NA > 0) {
+        return makeFixedIIR<NB, NA - 1>(name, b, a);
+    }
+    else if constexpr (NB > 1) {
+        return makeFixedIIR<NB - 1, FilterFactory::maxFixedIIRA>(name, b, a);
+    }
+    else {
+        return nullptr;
+    }
+}
+
+std::unique_ptr<Block> FilterFactory::makeFIR(const std::string& name, const std::vector<double>& b) {
+    if (b.empty()) throw std::invalid_argument("FIR coefficients must not be empty");
+    if (b.size() <= maxFixedFIR) return makeFixedFIR<maxFixedFIR>(name, b);
+    return std::make_unique<FIRFilter>(name, b);
+}
+
+std::unique_ptr<Block> FilterFactory::makeIIR(const std::string& name, const std::vector<double>& b, const std::vector<double>& a) {
+    if (b.empty()) throw std::invalid_argument("IIR feedforward coefficients must not be empty");
+    if (b.size() <= maxFixedIIRB && a.size() <= maxFixedIIRA)
+        return makeFixedIIR<maxFixedIIRB, maxFixedIIRA>(name, b, a);
+    return std::make_unique<IIRFilter>(name, b, a);
+}
@@ -0,0 +1,285 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Block.h"
+#include "Denormals.h"
+
+/**
+ * @brief КИХ-фильтр с числом коэффициентов, известным при компиляции.
+ * @details Аналог FIRFilter для коротких фильтров: коэффициенты и линия задержки
+ * хранятся в std::array, а сдвиг буфера и свертка разворачиваются компилятором
+ * полностью (через std::index_sequence). Порядок суммирования совпадает с FIRFilter,
+ * поэтому результаты побитно одинаковы.
+ * @tparam N Количество коэффициентов (больше нуля).
+ */
+template <size_t N>
+class FixedFIR : public Block {
+    static_assert(N > 0, "FixedFIR requires at least one coefficient");
+
+private:
+    std::array<double, N> b;    /**< Коэффициенты фильтра b0 ... b(N-1) */
+    std::array<double, N> xbuf; /**< Буфер входных значений (x[t] ... x[t-N+1]) */
+
+    template <size_t... I>
+    void shift(std::index_sequence<I...>) {
+        // xbuf[N-1] <- xbuf[N-2], ..., xbuf[1] <- xbuf[0] (слева направо)
+        ((xbuf[N - 1 - I] = xbuf[N - 2 - I]), ...);
+    }
+
+    template <size_t... I>
+    double dot(std::index_sequence<I...>) const {
+        return (0.0 + ... + (b[I] * xbuf[I])); // ((0 + b0*x0) + b1*x1) + ...
+    }
+
+public:
+    /**
+     * @brief Конструктор с коэффициентами, заданными массивом (может быть constexpr).
+     * @param nm Имя фильтра.
+     * @param coefficients Коэффициенты фильтра.
+     */
+    FixedFIR(const std::string& nm, const std::array<double, N>& coefficients)
+        : Block(nm), b(coefficients), xbuf{} {}
+
+    /**
+     * @brief Конструктор с коэффициентами в векторе.
+     * @param nm Имя фильтра.
+     * @param coefficients Вектор ровно из N коэффициентов.
+     * @throw std::invalid_argument Если размер вектора не равен N.
+     */
+    FixedFIR(const std::string& nm, const std::vector<double>& coefficients)
+        : Block(nm), b{}, xbuf{} {
+        if (coefficients.size() != N) throw std::invalid_argument("FixedFIR: wrong number of coefficients");
+        for (size_t i = 0; i < N; ++i) b[i] = coefficients[i];
+    }
+
+    /**
+     * @brief Обработка одного отсчета.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 1.
+     * @return y[t] = Σ b[i] * x[t-i].
+     */
+    double process(const std::vector<double>& inputs) override {
+        assert(inputs.size() == 1); // фильтр принимает 1 вход
+        return (*this)(inputs[0]);
+    }
+
+    /**
+     * @brief Обработка одиночного значения без промежуточного вектора.
+     * @param x_t Текущее значение входного сигнала.
+     * @return Отфильтрованное значение.
+     */
+    double operator()(double x_t) {
+        shift(std::make_index_sequence<N - 1>{});
+        xbuf[0] = x_t;
+        return dot(std::make_index_sequence<N>{});
+    }
+
+    /**
+     * @brief Сброс линии задержки.
+     */
+    void reset() override { xbuf.fill(0.0); }
+
+    /** @brief Копия блока вместе с текущим состоянием. */
+    std::unique_ptr<Block> clone() const override { return std::make_unique<FixedFIR<N>>(*this); }
+
+    /** @brief Память фильтра: N - 1 предыдущих отсчетов. */
+    bool getHistoryLength(size_t& length) const override {
+        length = N - 1;
+        return true;
+    }
+
+    /**
+     * @brief Блочная обработка без промежуточных векторов.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для выходных отсчетов (может совпадать с input).
+     * @param n Количество отсчетов.
+     */
+    void processBlock(const double* input, double* output, size_t n) override {
+        for (size_t i = 0; i < n; ++i) output[i] = (*this)(input[i]);
+    }
+
+    /**
+     * @brief Передаточная функция: H_in(z) * B(z).
+     * @param inputs Передаточные функции входов. Ожидается размер, равный 1.
+     * @param out Передаточная функция выхода.
+     * @return Всегда true: блок линейный.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override {
+        assert(inputs.size() == 1);
+        out = inputs[0].cascade(TransferFunction{ std::vector<double>(b.begin(), b.end()), { 1.0 } });
+        return true;
+    }
+
+    /** @brief Коэффициенты фильтра. */
+    const std::array<double, N>& coefficients() const { return b; }
+};
+
+/**
+ * @brief БИХ-фильтр с порядками числителя и знаменателя, известными при компиляции.
+ * @details Аналог IIRFilter: y[t] = Σ b[i] * x[t-i] + Σ a[j] * y[t-1-j], те же соглашения
+ * о знаке обратной связи и тот же порядок суммирования (результаты побитно одинаковы).
+ * Покрывает секции первого порядка и биквады, из которых состоит большинство графов.
+ * @tparam NB Количество коэффициентов прямой связи (больше нуля).
+ * @tparam NA Количество коэффициентов обратной связи (может быть 0).
+ */
+template <size_t NB, size_t NA>
+class FixedIIR : public Block {
+    static_assert(NB > 0, "FixedIIR requires at least one feedforward coefficient");
+
+private:
+    std::array<double, NB> b;    /**< Коэффициенты прямой связи */
+    std::array<double, NA> a;    /**< Коэффициенты обратной связи */
+    std::array<double, NB> xbuf; /**< Буфер входных значений */
+    std::array<double, NA> ybuf; /**< Буфер выходных значений */
+
+    template <size_t M, size_t... I>
+    static void shift(std::array<double, M>& buf, std::index_sequence<I...>) {
+        ((buf[M - 1 - I] = buf[M - 2 - I]), ...);
+    }
+
+    template <size_t... I>
+    double feedforward(std::index_sequence<I...>) const {
+        return (0.0 + ... + (b[I] * xbuf[I]));
+    }
+
+    template <size_t... I>
+    double feedback(double y, std::index_sequence<I...>) const {
+        return (y + ... + (a[I] * ybuf[I]));
+    }
+
+public:
+    /**
+     * @brief Конструктор с коэффициентами, заданными массивами (могут быть constexpr).
+     * @param nm Имя фильтра.
+     * @param bcoef Коэффициенты прямой связи.
+     * @param acoef Коэффициенты обратной связи.
+     */
+    FixedIIR(const std::string& nm, const std::array<double, NB>& bcoef, const std::array<double, NA>& acoef)
+        : Block(nm), b(bcoef), a(acoef), xbuf{}, ybuf{} {}
+
+    /**
+     * @brief Конструктор с коэффициентами в векторах.
+     * @param nm Имя фильтра.
+     * @param bcoef Вектор ровно из NB коэффициентов прямой связи.
+     * @param acoef Вектор ровно из NA коэффициентов обратной связи.
+     * @throw std::invalid_argument Если размеры векторов не совпадают с NB и NA.
+     */
+    FixedIIR(const std::string& nm, const std::vector<double>& bcoef, const std::vector<double>& acoef)
+        : Block(nm), b{}, a{}, xbuf{}, ybuf{} {
+        if (bcoef.size() != NB || acoef.size() != NA)
+            throw std::invalid_argument("FixedIIR: wrong number of coefficients");
+        for (size_t i = 0; i < NB; ++i) b[i] = bcoef[i];
+        for (size_t j = 0; j < NA; ++j) a[j] = acoef[j];
+    }
+
+    /**
+     * @brief Обработка одного отсчета.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 1.
+     * @return Выходное значение фильтра.
+     */
+    double process(const std::vector<double>& inputs) override {
+        assert(inputs.size() == 1); // фильтр принимает 1 вход
+        return (*this)(inputs[0]);
+    }
+
+    /**
+     * @brief Обработка одиночного значения без промежуточного вектора.
+     * @param x_t Текущее значение входного сигнала.
+     * @return Отфильтрованное значение.
+     */
+    double operator()(double x_t) {
+        shift(xbuf, std::make_index_sequence<NB - 1>{});
+        xbuf[0] = x_t;
+        double y = feedback(feedforward(std::make_index_sequence<NB>{}), std::make_index_sequence<NA>{});
+        if constexpr (NA > 0) {
+#ifdef DSP_DENORMAL_DC
+            y += DSP_ANTI_DENORMAL; // обратная связь не затухает до денормализованных чисел
+#endif
+            shift(ybuf, std::make_index_sequence<NA - 1>{});
+            ybuf[0] = y;
+        }
+        return y;
+    }
+
+    /**
+     * @brief Сброс буферов входных и выходных значений.
+     */
+    void reset() override {
+        xbuf.fill(0.0);
+        ybuf.fill(0.0);
+    }
+
+    /** @brief Копия блока вместе с текущим состоянием. */
+    std::unique_ptr<Block> clone() const override { return std::make_unique<FixedIIR<NB, NA>>(*this); }
+
+    /** @brief Память конечна только без обратной связи (NA = 0). */
+    bool getHistoryLength(size_t& length) const override {
+        length = NB - 1;
+        return NA == 0;
+    }
+
+    /**
+     * @brief Блочная обработка без промежуточных векторов.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для выходных отсчетов (может совпадать с input).
+     * @param n Количество отсчетов.
+     */
+    void processBlock(const double* input, double* output, size_t n) override {
+        for (size_t i = 0; i < n; ++i) output[i] = (*this)(input[i]);
+    }
+
+    /**
+     * @brief Передаточная функция: H_in(z) * B(z) / A(z), A(z) = 1 - Σ a[j] * z^-(j+1).
+     * @param inputs Передаточные функции входов. Ожидается размер, равный 1.
+     * @param out Передаточная функция выхода.
+     * @return Всегда true: блок линейный.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override {
+        assert(inputs.size() == 1);
+        std::vector<double> den(NA + 1, 0.0);
+        den[0] = 1.0;
+        for (size_t j = 0; j < NA; ++j)
+            den[j + 1] = -a[j];
+        out = inputs[0].cascade(TransferFunction{ std::vector<double>(b.begin(), b.end()), den });
+        return true;
+    }
+};
+
+/**
+ * @brief Фабрика фильтров: выбирает специализированную реализацию для малых порядков.
+ * @details Используется при построении графа (addFIR / addIIR в api.cpp). Для коротких
+ * фильтров возвращает FixedFIR / FixedIIR, для остальных — FIRFilter / IIRFilter.
+ * Результаты обработки в обоих случаях совпадают.
+ */
+class FilterFactory {
+public:
+    /** @brief Наибольшее число коэффициентов, для которого создается FixedFIR. */
+    static const size_t maxFixedFIR = 8;
+
+    /** @brief Наибольшие размеры (b, a), для которых создается FixedIIR (биквад). */
+    static const size_t maxFixedIIRB = 3;
+    static const size_t maxFixedIIRA = 2;
+
+    /**
+     * @brief Создать КИХ-фильтр.
+     * @param name Имя блока.
+     * @param b Коэффициенты фильтра (непустой вектор).
+     * @return FixedFIR<N> при N <= maxFixedFIR, иначе FIRFilter.
+     * @throw std::invalid_argument Если вектор коэффициентов пуст.
+     */
+    static std::unique_ptr<Block> makeFIR(const std::string& name, const std::vector<double>& b);
+
+    /**
+     * @brief Создать БИХ-фильтр в соглашениях IIRFilter.
+     * @param name Имя блока.
+     * @param b Коэффициенты прямой связи (непустой вектор).
+     * @param a Коэффициенты обратной связи.
+     * @return FixedIIR<NB, NA> для малых порядков, иначе IIRFilter.
+     * @throw std::invalid_argument Если вектор b пуст.
+     */
+    static std::unique_ptr<Block> makeIIR(const std::string& name, const std::vector<double>& b, const std::vector<double>& a);
+};
@@ -0,0 +1,186 @@
+#include "FixedPoint.h"
+#include "Generators.h"
+
+// Векторные ядра выбираются флагами компиляции (-march, DSP_MARCH_VARIANTS)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DSP_FIXED_AVX2
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#define DSP_FIXED_SSE2
+#define DSP_FIXED_SSE41
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DSP_FIXED_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DSP_FIXED_NEON
+#endif
+
+int64_t FixedPoint::shiftRound(int64_t acc, int shift, Rounding mode) {
+    if (shift <= 0) return acc;
+    int64_t q = acc >> shift; // арифметический сдвиг: округление вниз
+    if (mode == Rounding::Truncate) return q;
+    int64_t half = int64_t(1) << (shift - 1);
+    int64_t rem = acc & (2 * half - 1); // отброшенные разряды
+    if (rem > half || (rem == half && (mode == Rounding::Nearest || (q & 1)))) ++q;
+    return q;
+}
+
+double FixedPoint::roundValue(double x, Rounding mode) {
+    double f = std::floor(x);
+    if (mode == Rounding::Truncate) return f;
+    double d = x - f;
+    if (d > 0.5 || (d == 0.5 && (mode == Rounding::Nearest || std::fmod(f, 2.0) != 0.0))) f += 1.0;
+    return f;
+}
+
+int FixedPoint::headroom(const std::vector<double>& coefficients, int fracBits, int accBits) {
+    double largest = 0.0, total = 0.0;
+    for (double c : coefficients) {
+        if (!std::isfinite(c)) throw std::invalid_argument("Coefficients must be finite");
+        largest = std::max(largest, std::fabs(c));
+        total += std::fabs(c);
+    }
+    // |acc| <= Σ|q| * 2^f: с запасом 2^f на округление результата
+    const double limit = std::ldexp(1.0, fracBits) - 1.0;
+    const double accLimit = std::ldexp(1.0, accBits - 1 - fracBits) - 1.0;
+    for (int s = 0; s <= fracBits; ++s) {
+        double scale = std::ldexp(1.0, fracBits - s);
+        if (std::ceil(largest * scale) <= limit && std::ceil(total * scale) + coefficients.size() <= accLimit) return s;
+    }
+    throw std::invalid_argument("Coefficients are too large for the fixed-point format");
+}
+
+int32_t FixedPoint::dotQ15Scalar(const int16_t* a, const int16_t* b, size_t n) {
+    int32_t acc = 0;
+    for (size_t i = 0; i < n; ++i) acc += int32_t(a[i]) * b[i];
+    return acc;
+}
+
+int64_t FixedPoint::dotQ31Scalar(const int32_t* a, const int32_t* b, size_t n) {
+    int64_t acc = 0;
+    for (size_t i = 0; i < n; ++i) acc += int64_t(a[i]) * b[i];
+    return acc;
+}
+
+#if defined(DSP_FIXED_AVX2) || defined(DSP_FIXED_SSE2)
+static int32_t sumLanes32(__m128i v) {
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0x4E));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0xB1));
+    return _mm_cvtsi128_si32(v);
+}
+#endif
+
+int32_t FixedPoint::dotQ15(const int16_t* a, const int16_t* b, size_t n) {
+    size_t i = 0;
+    int32_t acc = 0;
+#if defined(DSP_FIXED_AVX2)
+    // _mm256_madd_epi16: 16 произведений, попарные суммы в 32-разрядных словах
+    __m256i sum = _mm256_setzero_si256();
+    for (; i + 16 <= n; i += 16) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(va, vb));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    if (i + 8 <= n) {
+        half = _mm_add_epi32(half, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))));
+        i += 8;
+    }
+    acc = sumLanes32(half);
+#elif defined(DSP_FIXED_SSE2)
+    __m128i sum = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(va, vb));
+    }
+    acc = sumLanes32(sum);
+#elif defined(DSP_FIXED_NEON)
+    int32x4_t sum = vdupq_n_s32(0);
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        sum = vmlal_s16(sum, vget_low_s16(va), vget_low_s16(vb));
+        sum = vmlal_s16(sum, vget_high_s16(va), vget_high_s16(vb));
+    }
+    int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+    acc = vget_lane_s32(vpadd_s32(pair, pair), 0);
+#endif
+    return acc + dotQ15Scalar(a + i, b + i, n - i); // хвост
+}
+
+int64_t FixedPoint::dotQ31(const int32_t* a, const int32_t* b, size_t n) {
+    size_t i = 0;
+    int64_t acc = 0;
+#if defined(DSP_FIXED_AVX2)
+    // _mm256_mul_epi32 умножает четные 32-разрядные слова; нечетные сдвигаются на их место
+    __m256i even = _mm256_setzero_si256(), odd = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        even = _mm256_add_epi64(even, _mm256_mul_epi32(va, vb));
+        odd = _mm256_add_epi64(odd, _mm256_mul_epi32(_mm256_srli_epi64(va, 32), _mm256_srli_epi64(vb, 32)));
+    }
+    __m256i sum = _mm256_add_epi64(even, odd);
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    acc = _mm_cvtsi128_si64(half) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(half, half));
+#elif defined(DSP_FIXED_SSE41)
+    __m128i even = _mm_setzero_si128(), odd = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        even = _mm_add_epi64(even, _mm_mul_epi32(va, vb));
+        odd = _mm_add_epi64(odd, _mm_mul_epi32(_mm_srli_epi64(va, 32), _mm_srli_epi64(vb, 32)));
+    }
+    __m128i sum = _mm_add_epi64(even, odd);
+    acc = _mm_cvtsi128_si64(sum) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(sum, sum));
+#elif defined(DSP_FIXED_NEON)
+    int64x2_t sum = vdupq_n_s64(0);
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t va = vld1q_s32(a + i);
+        int32x4_t vb = vld1q_s32(b + i);
+        sum = vmlal_s32(sum, vget_low_s32(va), vget_low_s32(vb));
+        sum = vmlal_s32(sum, vget_high_s32(va), vget_high_s32(vb));
+    }
+    acc = vgetq_lane_s64(sum, 0) + vgetq_lane_s64(sum, 1);
+#endif
+    // SSE2 без SSE4.1 не умеет знаковое 32x32 -> 64: Q31 считается скалярно
+    return acc + dotQ31Scalar(a + i, b + i, n - i);
+}
+
+const char* FixedPoint::kernelName() {
+#if defined(DSP_FIXED_AVX2)
+    return "avx2";
+#elif defined(DSP_FIXED_SSE41)
+    return "sse4.1";
+#elif defined(DSP_FIXED_SSE2)
+    return "sse2";
+#elif defined(DSP_FIXED_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+double FixedPoint::measureSNR(Block& reference, Block& quantized, size_t length, uint64_t seed, double rms) {
+    NoiseGenerator noise("snr-noise", rms, NoiseColor::White, seed);
+    std::vector<double> x(length), ref(length), q(length);
+    noise.processBlock(x.data(), x.data(), length);
+    reference.reset();
+    quantized.reset();
+    reference.processBlock(x.data(), ref.data(), length);
+    quantized.processBlock(x.data(), q.data(), length);
+    reference.reset();
+    quantized.reset();
+
+    double signal = 0.0, error = 0.0;
+    for (size_t i = 0; i < length; ++i) {
+        signal += ref[i] * ref[i];
+        error += (ref[i] - q[i]) * (ref[i] - q[i]);
+    }
+    if (error == 0.0) return std::numeric_limits<double>::infinity();
+    return 10.0 * std::log10(signal / error);
+}
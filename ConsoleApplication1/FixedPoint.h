@@ -0,0 +1,467 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "Block.h"
+
+/**
+ * @brief Режим округления при переводе в формат с фиксированной точкой.
+ * @details Применяется к входным отсчетам, к коэффициентам и к результату
+ * накопления (сдвиг аккумулятора вправо).
+ */
+enum class Rounding {
+    Truncate,  /**< Отбрасывание младших разрядов (округление вниз, как сдвиг в дополнительном коде) */
+    Nearest,   /**< К ближайшему, половина — вверх */
+    Convergent /**< К ближайшему, половина — к четному (без систематического смещения) */
+};
+
+/**
+ * @brief Арифметика и вычислительные ядра форматов Q15 (int16_t) и Q31 (int32_t).
+ * @details Значение x в формате Qf хранится как целое round(x * 2^f) в диапазоне
+ * [-1, 1 - 2^-f]. Выходы блоков насыщаются (saturate) к этому диапазону, а
+ * внутренние суммы накапливаются без переполнения за счет запаса по разрядам
+ * (см. headroom). Скалярные ядра (*Scalar) компилируются всегда и служат эталоном
+ * для векторных: целочисленная сумма не зависит от порядка, поэтому результаты
+ * побитно совпадают.
+ */
+class FixedPoint {
+public:
+    /**
+     * @brief Сдвиг аккумулятора вправо с округлением.
+     * @param acc Аккумулятор.
+     * @param shift Число отбрасываемых разрядов (0 ... 62).
+     * @param mode Режим округления.
+     * @return Округленное значение acc / 2^shift.
+     */
+    static int64_t shiftRound(int64_t acc, int shift, Rounding mode);
+
+    /**
+     * @brief Насыщение к диапазону типа T.
+     * @param value Значение.
+     * @return value, ограниченное пределами T.
+     */
+    template <class T>
+    static T saturate(int64_t value) {
+        if (value > std::numeric_limits<T>::max()) return std::numeric_limits<T>::max();
+        if (value < std::numeric_limits<T>::min()) return std::numeric_limits<T>::min();
+        return static_cast<T>(value);
+    }
+
+    /**
+     * @brief Округление вещественного числа до целого.
+     * @param x Число.
+     * @param mode Режим округления.
+     * @return Целое значение (в формате double).
+     */
+    static double roundValue(double x, Rounding mode);
+
+    /**
+     * @brief Перевод вещественного числа в формат с fracBits дробными разрядами с насыщением.
+     * @param x Число (NaN переводится в 0).
+     * @param fracBits Число дробных разрядов.
+     * @param mode Режим округления.
+     * @return Значение в формате T.
+     */
+    template <class T>
+    static T fromDouble(double x, int fracBits, Rounding mode) {
+        if (std::isnan(x)) return 0;
+        double q = roundValue(std::ldexp(x, fracBits), mode);
+        if (q >= static_cast<double>(std::numeric_limits<T>::max())) return std::numeric_limits<T>::max();
+        if (q <= static_cast<double>(std::numeric_limits<T>::min())) return std::numeric_limits<T>::min();
+        return static_cast<T>(q);
+    }
+
+    /**
+     * @brief Запас по разрядам для коэффициентов.
+     * @details Наименьший сдвиг s, при котором коэффициенты представимы в формате
+     * Q(fracBits - s) симметричным диапазоном ±(2^fracBits - 1) и сумма произведений
+     * с любыми входами формата не переполняет аккумулятор из accBits разрядов.
+     * @param coefficients Коэффициенты.
+     * @param fracBits Число дробных разрядов формата (15 или 31).
+     * @param accBits Разрядность аккумулятора (32 или 64).
+     * @return Сдвиг s (0 ... fracBits).
+     * @throw std::invalid_argument Если коэффициенты не конечны или слишком велики для формата.
+     */
+    static int headroom(const std::vector<double>& coefficients, int fracBits, int accBits);
+
+    /**
+     * @brief Квантование коэффициентов в формат Q(fracBits - shift).
+     * @param coefficients Коэффициенты.
+     * @param fracBits Число дробных разрядов формата.
+     * @param shift Запас по разрядам (headroom).
+     * @param mode Режим округления.
+     * @return Целочисленные коэффициенты.
+     */
+    template <class T>
+    static std::vector<T> quantize(const std::vector<double>& coefficients, int fracBits, int shift, Rounding mode) {
+        const T limit = std::numeric_limits<T>::max();
+        std::vector<T> q(coefficients.size());
+        for (size_t i = 0; i < coefficients.size(); ++i)
+            q[i] = std::max<T>(-limit, fromDouble<T>(coefficients[i], fracBits - shift, mode));
+        return q;
+    }
+
+    /**
+     * @brief Скалярное произведение Q15: Σ a[i] * b[i] в 32-разрядном аккумуляторе.
+     * @details Векторное ядро (AVX2, SSE2 или NEON — по флагам компиляции).
+     * Требования: a[i] != -32768 и Σ|a[i]| < 2^16 (обеспечивается quantize и headroom).
+     */
+    static int32_t dotQ15(const int16_t* a, const int16_t* b, size_t n);
+
+    /** @brief Скалярная реализация dotQ15 (эталон для векторных ядер). */
+    static int32_t dotQ15Scalar(const int16_t* a, const int16_t* b, size_t n);
+
+    /**
+     * @brief Скалярное произведение Q31: Σ a[i] * b[i] в 64-разрядном аккумуляторе.
+     * @details Векторное ядро (AVX2, SSE4.1 или NEON — по флагам компиляции).
+     * Требование: Σ|a[i]| < 2^32 (обеспечивается headroom).
+     */
+    static int64_t dotQ31(const int32_t* a, const int32_t* b, size_t n);
+
+    /** @brief Скалярная реализация dotQ31 (эталон для векторных ядер). */
+    static int64_t dotQ31Scalar(const int32_t* a, const int32_t* b, size_t n);
+
+    /**
+     * @brief Набор инструкций, выбранный при компиляции для ядер dotQ15 / dotQ31.
+     * @return "avx2", "sse4.1", "sse2", "neon" или "scalar".
+     */
+    static const char* kernelName();
+
+    /**
+     * @brief Отношение сигнал/шум квантования: выход эталонного блока против выхода
+     * блока с фиксированной точкой на белом гауссовском шуме.
+     * @details Оба блока сбрасываются до и после замера.
+     * @param reference Эталонный блок (double).
+     * @param quantized Блок с фиксированной точкой.
+     * @param length Длина тестового сигнала.
+     * @param seed Зерно генератора шума.
+     * @param rms Среднеквадратичное значение тестового сигнала.
+     * @return 10 * log10(Σ ref^2 / Σ (ref - q)^2) в дБ; бесконечность при точном совпадении.
+     */
+    static double measureSNR(Block& reference, Block& quantized, size_t length = 1 << 16,
+        uint64_t seed = 1, double rms = 0.125);
+};
+
+/**
+ * @brief Параметры формата для типа отсчета: Q15 для int16_t, Q31 для int32_t.
+ */
+template <class T>
+struct QFormat;
+
+template <>
+struct QFormat<int16_t> {
+    static constexpr int fracBits = 15;   /**< Дробных разрядов */
+    static constexpr int firAccBits = 32; /**< Аккумулятор КИХ-ядра */
+    static int32_t dot(const int16_t* a, const int16_t* b, size_t n) { return FixedPoint::dotQ15(a, b, n); }
+};
+
+template <>
+struct QFormat<int32_t> {
+    static constexpr int fracBits = 31;
+    static constexpr int firAccBits = 64;
+    static int64_t dot(const int32_t* a, const int32_t* b, size_t n) { return FixedPoint::dotQ31(a, b, n); }
+};
+
+/**
+ * @brief КИХ-фильтр с фиксированной точкой (Q15 или Q31).
+ * @details Вход квантуется, коэффициенты хранятся в формате Q(f - s) с запасом s
+ * разрядов (FixedPoint::headroom), свертка считается целочисленным векторным ядром
+ * без переполнения, результат сдвигается с округлением и насыщается к формату.
+ * Выход — точное значение формата в double, поэтому цепочка таких блоков не вносит
+ * дополнительной ошибки на стыках. Линия задержки хранится подряд с запасом на блок
+ * входов, чтобы каждое окно свертки было непрерывным.
+ * @tparam T int16_t (Q15) или int32_t (Q31).
+ */
+template <class T>
+class FixedPointFIR : public Block {
+    static constexpr size_t chunkSize = 256; /**< Входов за один проход processBlock */
+    static constexpr int fracBits = QFormat<T>::fracBits;
+
+private:
+    std::vector<T> h;    /**< Коэффициенты в обратном порядке: h[j] = b[N-1-j] */
+    std::vector<T> line; /**< N - 1 предыдущих входов и до chunkSize новых */
+    int shift;           /**< Запас по разрядам коэффициентов */
+    Rounding rounding;   /**< Режим округления */
+
+public:
+    /**
+     * @brief Конструктор: квантование коэффициентов.
+     * @param nm Имя фильтра.
+     * @param coefficients Коэффициенты b0 ... b(N-1) в double.
+     * @param mode Режим округления.
+     * @throw std::invalid_argument Если коэффициентов нет или они не представимы в формате.
+     */
+    FixedPointFIR(const std::string& nm, const std::vector<double>& coefficients, Rounding mode = Rounding::Nearest)
+        : Block(nm), shift(0), rounding(mode) {
+        if (coefficients.empty()) throw std::invalid_argument("FIR coefficients must not be empty");
+        shift = FixedPoint::headroom(coefficients, fracBits, QFormat<T>::firAccBits);
+        h = FixedPoint::quantize<T>(coefficients, fracBits, shift, mode);
+        std::reverse(h.begin(), h.end());
+        line.assign(h.size() - 1 + chunkSize, 0);
+    }
+
+    /**
+     * @brief Обработка одного отсчета.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 1.
+     * @return Отфильтрованное значение.
+     */
+    double process(const std::vector<double>& inputs) override {
+        assert(inputs.size() == 1);
+        double y;
+        processBlock(inputs.data(), &y, 1);
+        return y;
+    }
+
+    /**
+     * @brief Блочная обработка: квантование порции входов, свертки, сдвиг линии задержки.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для выходных отсчетов (может совпадать с input).
+     * @param n Количество отсчетов.
+     */
+    void processBlock(const double* input, double* output, size_t n) override {
+        const size_t taps = h.size();
+        const double scale = std::ldexp(1.0, -fracBits);
+        for (size_t pos = 0; pos < n; pos += chunkSize) {
+            size_t m = std::min(chunkSize, n - pos);
+            for (size_t i = 0; i < m; ++i)
+                line[taps - 1 + i] = FixedPoint::fromDouble<T>(input[pos + i], fracBits, rounding);
+            for (size_t i = 0; i < m; ++i) {
+                int64_t acc = QFormat<T>::dot(h.data(), line.data() + i, taps);
+                output[pos + i] = scale * FixedPoint::saturate<T>(FixedPoint::shiftRound(acc, fracBits - shift, rounding));
+            }
+            std::copy(line.begin() + m, line.begin() + m + taps - 1, line.begin());
+        }
+    }
+
+    /** @brief Сброс линии задержки. */
+    void reset() override { std::fill(line.begin(), line.end(), T(0)); }
+
+    /** @brief Копия блока вместе с текущим состоянием. */
+    std::unique_ptr<Block> clone() const override { return std::make_unique<FixedPointFIR<T>>(*this); }
+
+    /** @brief Память фильтра: N - 1 предыдущих отсчетов. */
+    bool getHistoryLength(size_t& length) const override {
+        length = h.size() - 1;
+        return true;
+    }
+
+    /**
+     * @brief Передаточная функция с квантованными коэффициентами (без учета шума округления).
+     * @param inputs Передаточные функции входов. Ожидается размер, равный 1.
+     * @param out Передаточная функция выхода.
+     * @return Всегда true.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override {
+        assert(inputs.size() == 1);
+        out = inputs[0].cascade(TransferFunction{ coefficients(), { 1.0 } });
+        return true;
+    }
+
+    /** @brief Квантованные коэффициенты b0 ... b(N-1) в double. */
+    std::vector<double> coefficients() const {
+        std::vector<double> b(h.size());
+        for (size_t i = 0; i < h.size(); ++i) b[i] = std::ldexp(static_cast<double>(h[h.size() - 1 - i]), shift - fracBits);
+        return b;
+    }
+
+    /** @brief Запас по разрядам коэффициентов. */
+    int headroom() const { return shift; }
+};
+
+/**
+ * @brief Биквадратная секция с фиксированной точкой (прямая форма I).
+ * @details y[t] = b0 x[t] + b1 x[t-1] + b2 x[t-2] + a1 y[t-1] + a2 y[t-2] — тот же знак
+ * обратной связи, что у IIRFilter. Произведения накапливаются в 64-разрядном
+ * аккумуляторе, выход насыщается и хранится в формате, поэтому предельные циклы
+ * переполнения невозможны. Денормализованных чисел в целочисленной обратной связи нет.
+ * @tparam T int16_t (Q15) или int32_t (Q31).
+ */
+template <class T>
+class FixedPointBiquad : public Block {
+    static constexpr int fracBits = QFormat<T>::fracBits;
+
+private:
+    std::vector<T> c;  /**< b0, b1, b2, a1, a2 в формате Q(f - s) */
+    T x1, x2, y1, y2;  /**< Состояние: два входа и два выхода */
+    int shift;         /**< Запас по разрядам коэффициентов */
+    Rounding rounding; /**< Режим округления */
+
+public:
+    /**
+     * @brief Конструктор: квантование коэффициентов.
+     * @param nm Имя блока.
+     * @param b Коэффициенты прямой связи (до трех).
+     * @param a Коэффициенты обратной связи (до двух).
+     * @param mode Режим округления.
+     * @throw std::invalid_argument Если коэффициентов больше, чем в биквадратной секции.
+     */
+    FixedPointBiquad(const std::string& nm, const std::vector<double>& b, const std::vector<double>& a,
+        Rounding mode = Rounding::Nearest)
+        : Block(nm), x1(0), x2(0), y1(0), y2(0), shift(0), rounding(mode) {
+        if (b.empty() || b.size() > 3 || a.size() > 2) throw std::invalid_argument("Biquad takes up to 3 feedforward and 2 feedback coefficients");
+        std::vector<double> all(5, 0.0);
+        std::copy(b.begin(), b.end(), all.begin());
+        std::copy(a.begin(), a.end(), all.begin() + 3);
+        shift = FixedPoint::headroom(all, fracBits, 64);
+        c = FixedPoint::quantize<T>(all, fracBits, shift, mode);
+    }
+
+    /**
+     * @brief Обработка одного отсчета.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 1.
+     * @return Отфильтрованное значение.
+     */
+    double process(const std::vector<double>& inputs) override {
+        assert(inputs.size() == 1);
+        return (*this)(inputs[0]);
+    }
+
+    /**
+     * @brief Обработка одиночного значения.
+     * @param x_t Текущее значение входного сигнала.
+     * @return Отфильтрованное значение.
+     */
+    double operator()(double x_t) {
+        T x = FixedPoint::fromDouble<T>(x_t, fracBits, rounding);
+        int64_t acc = int64_t(c[0]) * x + int64_t(c[1]) * x1 + int64_t(c[2]) * x2
+            + int64_t(c[3]) * y1 + int64_t(c[4]) * y2;
+        T y = FixedPoint::saturate<T>(FixedPoint::shiftRound(acc, fracBits - shift, rounding));
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        return std::ldexp(static_cast<double>(y), -fracBits);
+    }
+
+    /**
+     * @brief Блочная обработка без промежуточных векторов.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для выходных отсчетов (может совпадать с input).
+     * @param n Количество отсчетов.
+     */
+    void processBlock(const double* input, double* output, size_t n) override {
+        for (size_t i = 0; i < n; ++i) output[i] = (*this)(input[i]);
+    }
+
+    /** @brief Сброс состояния. */
+    void reset() override { x1 = x2 = y1 = y2 = 0; }
+
+    /** @brief Копия блока вместе с текущим состоянием. */
+    std::unique_ptr<Block> clone() const override { return std::make_unique<FixedPointBiquad<T>>(*this); }
+
+    /**
+     * @brief Передаточная функция с квантованными коэффициентами (без учета шума округления).
+     * @param inputs Передаточные функции входов. Ожидается размер, равный 1.
+     * @param out Передаточная функция выхода.
+     * @return Всегда true.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override {
+        assert(inputs.size() == 1);
+        std::vector<double> q = coefficients();
+        out = inputs[0].cascade(TransferFunction{ { q[0], q[1], q[2] }, { 1.0, -q[3], -q[4] } });
+        return true;
+    }
+
+    /** @brief Квантованные коэффициенты b0, b1, b2, a1, a2 в double. */
+    std::vector<double> coefficients() const {
+        std::vector<double> q(c.size());
+        for (size_t i = 0; i < c.size(); ++i) q[i] = std::ldexp(static_cast<double>(c[i]), shift - fracBits);
+        return q;
+    }
+
+    /** @brief Запас по разрядам коэффициентов. */
+    int headroom() const { return shift; }
+};
+
+/**
+ * @brief Сумматор с фиксированной точкой: y = sat(u * x1 + v * x2).
+ * @details В отличие от Summator результат насыщается к диапазону формата,
+ * а не переполняется.
+ * @tparam T int16_t (Q15) или int32_t (Q31).
+ */
+template <class T>
+class FixedPointSummator : public Block {
+    static constexpr int fracBits = QFormat<T>::fracBits;
+
+private:
+    T u, v;            /**< Весовые коэффициенты в формате Q(f - s) */
+    int shift;         /**< Запас по разрядам коэффициентов */
+    Rounding rounding; /**< Режим округления */
+
+public:
+    /**
+     * @brief Конструктор сумматора.
+     * @param nm Имя блока.
+     * @param uu Коэффициент для первого входа.
+     * @param vv Коэффициент для второго входа.
+     * @param mode Режим округления.
+     */
+    FixedPointSummator(const std::string& nm, double uu, double vv, Rounding mode = Rounding::Nearest)
+        : Block(nm), u(0), v(0), shift(0), rounding(mode) {
+        shift = FixedPoint::headroom({ uu, vv }, fracBits, 64);
+        std::vector<T> q = FixedPoint::quantize<T>({ uu, vv }, fracBits, shift, mode);
+        u = q[0];
+        v = q[1];
+    }
+
+    /**
+     * @brief Обработка входных данных.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 2.
+     * @return Результат взвешенного суммирования с насыщением.
+     */
+    double process(const std::vector<double>& inputs) override {
+        assert(inputs.size() == 2);
+        return (*this)(inputs[0], inputs[1]);
+    }
+
+    /**
+     * @brief Взвешенная сумма двух значений.
+     * @param x1 Значение первого сигнала.
+     * @param x2 Значение второго сигнала.
+     * @return sat(u * x1 + v * x2).
+     */
+    double operator()(double x1, double x2) {
+        int64_t acc = int64_t(u) * FixedPoint::fromDouble<T>(x1, fracBits, rounding)
+            + int64_t(v) * FixedPoint::fromDouble<T>(x2, fracBits, rounding);
+        T y = FixedPoint::saturate<T>(FixedPoint::shiftRound(acc, fracBits - shift, rounding));
+        return std::ldexp(static_cast<double>(y), -fracBits);
+    }
+
+    /** @brief Блок без памяти: сбрасывать нечего. */
+    void reset() override {}
+
+    /** @brief Копия блока. */
+    std::unique_ptr<Block> clone() const override { return std::make_unique<FixedPointSummator<T>>(*this); }
+
+    /** @brief Память сумматора: выход зависит только от текущих входов. */
+    bool getHistoryLength(size_t& length) const override {
+        length = 0;
+        return true;
+    }
+
+    /**
+     * @brief Передаточная функция с квантованными коэффициентами: u * H1(z) + v * H2(z).
+     * @param inputs Передаточные функции двух входов.
+     * @param out Передаточная функция выхода.
+     * @return Всегда true.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override {
+        assert(inputs.size() == 2);
+        out = TransferFunction::weightedSum(std::ldexp(static_cast<double>(u), shift - fracBits), inputs[0],
+            std::ldexp(static_cast<double>(v), shift - fracBits), inputs[1]);
+        return true;
+    }
+};
+
+using Q15FIR = FixedPointFIR<int16_t>;            /**< КИХ-фильтр Q15 */
+using Q31FIR = FixedPointFIR<int32_t>;            /**< КИХ-фильтр Q31 */
+using Q15Biquad = FixedPointBiquad<int16_t>;      /**< Биквадратная секция Q15 */
+using Q31Biquad = FixedPointBiquad<int32_t>;      /**< Биквадратная секция Q31 */
+using Q15Summator = FixedPointSummator<int16_t>;  /**< Сумматор Q15 */
+using Q31Summator = FixedPointSummator<int32_t>;  /**< Сумматор Q31 */
@@ -0,0 +1,266 @@
+#include "Generators.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+static const double PI = 3.14159265358979323846;
+
+// частота (1 = Найквист) -> приращение фазы за отсчет в 2^-64 периода
+static uint64_t phaseIncrement(double frequency) {
+    if (!(frequency >= 0.0 && frequency <= 1.0))
+        throw std::invalid_argument("Generator frequency must be in [0, 1] (1 = Nyquist)");
+    return static_cast<uint64_t>(std::ldexp(frequency, 63) + 0.5);
+}
+
+// доля периода в [0, 1) для фазы в 2^-64 периода (старшие 53 бита)
+static double phaseFraction(uint64_t phase) {
+    return std::ldexp(static_cast<double>(phase >> 11), -53);
+}
+
+// ===== Xoshiro256 =====
+
+static uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+Xoshiro256::Xoshiro256(uint64_t seedValue) {
+    seed(seedValue);
+}
+
+void Xoshiro256::seed(uint64_t seedValue) {
+    for (size_t k = 0; k < lanes; ++k)
+        for (size_t w = 0; w < 4; ++w) s[w][k] = splitmix64(seedValue);
+}
+
+void Xoshiro256::fillUniform(double* out, size_t n) {
+    for (size_t i = 0; i < n; i += lanes) {
+        // внутренний цикл по потокам без зависимостей — векторизуется
+        for (size_t k = 0; k < lanes; ++k) {
+            uint64_t result = s[0][k] + s[3][k];
+            uint64_t t = s[1][k] << 17;
+            s[2][k] ^= s[0][k];
+            s[3][k] ^= s[1][k];
+            s[1][k] ^= s[2][k];
+            s[0][k] ^= s[3][k];
+            s[2][k] ^= t;
+            s[3][k] = (s[3][k] << 45) | (s[3][k] >> 19);
+
+            // старшие 52 бита в мантиссу: число в [1, 2) без преобразования целое -> double
+            uint64_t bits = (result >> 12) | 0x3FF0000000000000ull;
+            double u;
+            std::memcpy(&u, &bits, sizeof(u));
+            out[i + k] = 2.0 - u; // (0, 1]: допустимый аргумент логарифма
+        }
+    }
+}
+
+// ===== Generator =====
+
+Generator::Generator(const std::string& nm) : Block(nm), cache(), index(0) {}
+
+void Generator::processBlock(const double* input, double* output, size_t n) {
+    (void)input;
+    while (n > 0) {
+        size_t pos = index % blockSize;
+        if (pos == 0 && n >= blockSize) {
+            // целые блоки пишутся сразу в выходной массив
+            fillBlock(index, output);
+            index += blockSize;
+            output += blockSize;
+            n -= blockSize;
+            continue;
+        }
+        if (pos == 0) fillBlock(index, cache.data());
+        size_t len = std::min(n, blockSize - pos);
+        std::copy(cache.begin() + pos, cache.begin() + pos + len, output);
+        index += len;
+        output += len;
+        n -= len;
+    }
+}
+
+double Generator::operator()() {
+    double y;
+    processBlock(nullptr, &y, 1);
+    return y;
+}
+
+double Generator::process(const std::vector<double>& inputs) {
+    (void)inputs; // источник: входы не используются
+    return (*this)();
+}
+
+void Generator::reset() {
+    index = 0;
+}
+
+// ===== SineGenerator =====
+
+SineGenerator::SineGenerator(const std::string& nm, double amp, double frequency, double phi)
+    : Generator(nm), amplitude(amp), increment(phaseIncrement(frequency)), phase(phi) {
+    double step = phaseFraction(8 * increment);
+    rotCos = std::cos(2.0 * PI * step);
+    rotSin = std::sin(2.0 * PI * step);
+}
+
+void SineGenerator::fillBlock(size_t start, double* out) {
+    // точная фаза первых 8 отсчетов (целочисленное умножение по модулю 2^64)
+    double s[8], c[8];
+    for (size_t k = 0; k < 8; ++k) {
+        double x = 2.0 * PI * phaseFraction(increment * static_cast<uint64_t>(start + k)) + phase;
+        s[k] = std::sin(x);
+        c[k] = std::cos(x);
+    }
+    for (size_t m = 0; m < blockSize; m += 8) {
+        for (size_t k = 0; k < 8; ++k) {
+            out[m + k] = amplitude * s[k];
+            double sn = s[k] * rotCos + c[k] * rotSin;
+            c[k] = c[k] * rotCos - s[k] * rotSin;
+            s[k] = sn;
+        }
+    }
+}
+
+std::unique_ptr<Block> SineGenerator::clone() const {
+    return std::make_unique<SineGenerator>(*this);
+}
+
+// ===== SquareGenerator =====
+
+SquareGenerator::SquareGenerator(const std::string& nm, double amp, double frequency, double dutyCycle)
+    : Generator(nm), amplitude(amp), increment(phaseIncrement(frequency)), duty(dutyCycle) {
+    if (!(dutyCycle >= 0.0 && dutyCycle <= 1.0))
+        throw std::invalid_argument("Duty cycle must be in [0, 1]");
+}
+
+void SquareGenerator::fillBlock(size_t start, double* out) {
+    uint64_t phase = increment * static_cast<uint64_t>(start);
+    for (size_t i = 0; i < blockSize; ++i) {
+        out[i] = (phaseFraction(phase) < duty) ? amplitude : -amplitude;
+        phase += increment;
+    }
+}
+
+std::unique_ptr<Block> SquareGenerator::clone() const {
+    return std::make_unique<SquareGenerator>(*this);
+}
+
+// ===== ChirpGenerator =====
+
+ChirpGenerator::ChirpGenerator(const std::string& nm, double amp, double f0, double f1, size_t sweepLength)
+    : Generator(nm), amplitude(amp), c0(f0 / 2.0), c1(f1 / 2.0), length(sweepLength) {
+    if (!(f0 >= 0.0 && f0 <= 1.0 && f1 >= 0.0 && f1 <= 1.0))
+        throw std::invalid_argument("Generator frequency must be in [0, 1] (1 = Nyquist)");
+    if (sweepLength == 0) throw std::invalid_argument("Sweep length must be positive");
+}
+
+void ChirpGenerator::fillBlock(size_t start, double* out) {
+    double slope = (c1 - c0) / (2.0 * static_cast<double>(length));
+    size_t t = start % length;
+    for (size_t i = 0; i < blockSize; ++i) {
+        double td = static_cast<double>(t);
+        double cyc = td * (c0 + slope * td);
+        cyc -= std::floor(cyc);
+        out[i] = amplitude * std::sin(2.0 * PI * cyc);
+        if (++t == length) t = 0;
+    }
+}
+
+std::unique_ptr<Block> ChirpGenerator::clone() const {
+    return std::make_unique<ChirpGenerator>(*this);
+}
+
+// ===== NoiseGenerator =====
+
+// фильтр П. Келлета: полюса и веса однополюсных звеньев, прямой путь и задержанный белый шум
+static const double PINK_POLE[6] = { 0.99886, 0.99332, 0.96900, 0.86650, 0.55000, -0.7616 };
+static const double PINK_GAIN[6] = { 0.0555179, 0.0750759, 0.1538520, 0.3104856, 0.5329522, -0.0168980 };
+static const double PINK_DIRECT = 0.5362;
+static const double PINK_DELAYED = 0.115926;
+static const size_t PINK_WARMUP = 8192; // ~9 постоянных времени самого медленного звена
+
+// СКО розового фильтра при белом входе единичной дисперсии (по импульсной характеристике)
+static double pinkDeviation() {
+    static const double value = [] {
+        // h[0] = D + sum(g), h[n] = E * [n == 1] + sum(g * p^n)
+        double h = PINK_DIRECT;
+        double term[6];
+        for (size_t k = 0; k < 6; ++k) {
+            term[k] = PINK_GAIN[k];
+            h += term[k];
+        }
+        double sum = h * h;
+        for (size_t n = 1; n < 40000; ++n) {
+            h = (n == 1) ? PINK_DELAYED : 0.0;
+            for (size_t k = 0; k < 6; ++k) {
+                term[k] *= PINK_POLE[k];
+                h += term[k];
+            }
+            sum += h * h;
+        }
+        return std::sqrt(sum);
+    }();
+    return value;
+}
+
+NoiseGenerator::NoiseGenerator(const std::string& nm, double amp, NoiseColor noiseColor, uint64_t seed)
+    : Generator(nm), amplitude(amp), color(noiseColor), seedValue(seed), rng(seed), pink() {
+    restart();
+}
+
+void NoiseGenerator::whiteBlock(double* out) {
+    // Бокс — Мюллер: u1 из первой половины блока, u2 — из второй; пары дают два независимых отсчета
+    const size_t half = blockSize / 2;
+    double u[blockSize];
+    rng.fillUniform(u, blockSize);
+    for (size_t i = 0; i < half; ++i) {
+        double r = std::sqrt(-2.0 * std::log(u[i]));
+        double a = 2.0 * PI * u[half + i];
+        out[i] = r * std::cos(a);
+        out[half + i] = r * std::sin(a);
+    }
+}
+
+void NoiseGenerator::fillBlock(size_t start, double* out) {
+    (void)start; // последовательность определяется зерном и числом уже выданных блоков
+    whiteBlock(out);
+    if (color == NoiseColor::White) {
+        for (size_t i = 0; i < blockSize; ++i) out[i] *= amplitude;
+        return;
+    }
+
+    double scale = amplitude / pinkDeviation();
+    for (size_t i = 0; i < blockSize; ++i) {
+        double white = out[i];
+        double y = pink[6] + PINK_DIRECT * white;
+        for (size_t k = 0; k < 6; ++k) {
+            pink[k] = PINK_POLE[k] * pink[k] + PINK_GAIN[k] * white;
+            y += pink[k];
+        }
+        pink[6] = PINK_DELAYED * white;
+        out[i] = scale * y;
+    }
+}
+
+void NoiseGenerator::restart() {
+    rng.seed(seedValue);
+    pink.fill(0.0);
+    if (color == NoiseColor::Pink) {
+        // переходный процесс фильтра: сигнал сразу имеет стационарную дисперсию
+        double skip[blockSize];
+        for (size_t n = 0; n < PINK_WARMUP; n += blockSize) fillBlock(0, skip);
+    }
+}
+
+void NoiseGenerator::reset() {
+    Generator::reset();
+    restart();
+}
+
+std::unique_ptr<Block> NoiseGenerator::clone() const {
+    return std::make_unique<NoiseGenerator>(*this);
+}
@@ -0,0 +1,261 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Block.h"
+
+/**
+ * @brief Генератор псевдослучайных чисел xoshiro256+ в четырех независимых потоках.
+ * @details Состояние хранится по словам (s[слово][поток]), поэтому один шаг всех
+ * потоков — несколько векторных операций (сдвиги, xor, сложение). Поток k выдает
+ * числа с номерами k, k + 4, k + 8, ... Начальное состояние получается из зерна
+ * через splitmix64, поэтому одно и то же зерно дает одну и ту же последовательность
+ * на любой платформе.
+ */
+class Xoshiro256 {
+public:
+    static const size_t lanes = 4; /**< Число независимых потоков */
+
+private:
+    uint64_t s[4][lanes]; /**< Состояние: слово x поток */
+
+public:
+    /**
+     * @brief Конструктор генератора.
+     * @param seedValue Зерно.
+     */
+    explicit Xoshiro256(uint64_t seedValue);
+
+    /**
+     * @brief Переустанавливает зерно (последовательность начинается сначала).
+     * @param seedValue Зерно.
+     */
+    void seed(uint64_t seedValue);
+
+    /**
+     * @brief Равномерно распределенные числа в полуинтервале (0, 1] с шагом 2^-52.
+     * @param out Массив для результата.
+     * @param n Количество чисел (кратно lanes).
+     */
+    void fillUniform(double* out, size_t n);
+};
+
+/**
+ * @brief Базовый класс блоков-источников (генераторов сигналов).
+ * @details Генератор не имеет входов: внешний вход системы, который получает блок без
+ * связей, игнорируется. Поэтому генератор можно подключить ко входу фильтров
+ * (connect) и получать сигнал целиком внутри графа, либо записывать его напрямую
+ * в буфер (processBlock, C API generateSignal).
+ *
+ * Отсчеты вычисляются блоками по blockSize, выровненными по номеру отсчета, поэтому
+ * результат не зависит от того, какими порциями запрашивается сигнал.
+ */
+class Generator : public Block {
+public:
+    static const size_t blockSize = 64; /**< Размер блока генерации */
+
+private:
+    std::array<double, blockSize> cache; /**< Текущий блок (для запросов не кратных blockSize) */
+    size_t index;                        /**< Номер следующего отсчета */
+
+protected:
+    /**
+     * @brief Конструктор генератора.
+     * @param nm Имя блока.
+     */
+    explicit Generator(const std::string& nm);
+
+    /**
+     * @brief Вычисляет очередной блок отсчетов.
+     * @details Вызывается для блоков подряд, начиная с нулевого (после reset).
+     * @param start Номер первого отсчета блока (кратен blockSize).
+     * @param out Массив из blockSize отсчетов.
+     */
+    virtual void fillBlock(size_t start, double* out) = 0;
+
+public:
+    /**
+     * @brief Следующий отсчет сигнала.
+     * @param inputs Входы блока (игнорируются).
+     * @return Отсчет сигнала.
+     */
+    double process(const std::vector<double>& inputs) override;
+
+    /**
+     * @brief Записывает следующие n отсчетов в output.
+     * @param input Внешний вход (игнорируется, может быть nullptr).
+     * @param output Массив для отсчетов.
+     * @param n Количество отсчетов.
+     */
+    void processBlock(const double* input, double* output, size_t n) override;
+
+    /**
+     * @brief Возврат к началу сигнала.
+     */
+    void reset() override;
+
+    /**
+     * @brief Следующий отсчет сигнала.
+     * @return Отсчет сигнала.
+     */
+    double operator()();
+
+    /**
+     * @brief Номер следующего отсчета.
+     * @return Количество уже выданных отсчетов.
+     */
+    size_t position() const { return index; }
+};
+
+/**
+ * @brief Синусоидальный генератор: A * sin(pi * f * n + phi).
+ * @details Частота нормирована к частоте Найквиста (как в функциях проектирования).
+ * Фаза считается в 64-битной фиксированной точке (n * increment по модулю 2^64), поэтому
+ * она точна при любой длине сигнала. В каждом блоке точные значения вычисляются для
+ * первых 8 отсчетов, остальные — поворотом на угол 8 * pi * f (8 независимых цепочек
+ * умножений, векторизуются); погрешность не накапливается между блоками.
+ */
+class SineGenerator : public Generator {
+private:
+    double amplitude;   /**< Амплитуда A */
+    uint64_t increment; /**< Приращение фазы за отсчет, 2^-64 периода */
+    double phase;       /**< Начальная фаза, рад */
+    double rotCos;      /**< Косинус приращения фазы за 8 отсчетов */
+    double rotSin;      /**< Синус приращения фазы за 8 отсчетов */
+
+protected:
+    void fillBlock(size_t start, double* out) override;
+
+public:
+    /**
+     * @brief Конструктор синусоидального генератора.
+     * @param nm Имя блока.
+     * @param amp Амплитуда.
+     * @param frequency Частота, нормированная к частоте Найквиста (0 ... 1).
+     * @param phi Начальная фаза в радианах.
+     * @throw std::invalid_argument Если частота вне диапазона [0, 1].
+     */
+    SineGenerator(const std::string& nm, double amp, double frequency, double phi = 0.0);
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+};
+
+/**
+ * @brief Генератор прямоугольного сигнала (меандра): +A в первой части периода, -A в остальной.
+ */
+class SquareGenerator : public Generator {
+private:
+    double amplitude;   /**< Амплитуда A */
+    uint64_t increment; /**< Приращение фазы за отсчет, 2^-64 периода */
+    double duty;        /**< Доля периода со значением +A */
+
+protected:
+    void fillBlock(size_t start, double* out) override;
+
+public:
+    /**
+     * @brief Конструктор генератора меандра.
+     * @param nm Имя блока.
+     * @param amp Амплитуда.
+     * @param frequency Частота, нормированная к частоте Найквиста (0 ... 1).
+     * @param dutyCycle Коэффициент заполнения (0 ... 1), 0.5 — меандр.
+     * @throw std::invalid_argument Если частота или коэффициент заполнения вне [0, 1].
+     */
+    SquareGenerator(const std::string& nm, double amp, double frequency, double dutyCycle = 0.5);
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+};
+
+/**
+ * @brief Генератор линейно-частотно-модулированного сигнала (chirp).
+ * @details Частота линейно меняется от f0 до f1 за sweepLength отсчетов, затем развертка
+ * повторяется: x[n] = A * sin(2pi * (c0 * t + (c1 - c0) * t^2 / (2L))), t = n mod L.
+ */
+class ChirpGenerator : public Generator {
+private:
+    double amplitude;   /**< Амплитуда A */
+    double c0;          /**< Начальная частота, периодов на отсчет */
+    double c1;          /**< Конечная частота, периодов на отсчет */
+    size_t length;      /**< Длина развертки L */
+
+protected:
+    void fillBlock(size_t start, double* out) override;
+
+public:
+    /**
+     * @brief Конструктор ЛЧМ-генератора.
+     * @param nm Имя блока.
+     * @param amp Амплитуда.
+     * @param f0 Начальная частота, нормированная к частоте Найквиста.
+     * @param f1 Конечная частота, нормированная к частоте Найквиста.
+     * @param sweepLength Длина развертки в отсчетах (больше нуля).
+     * @throw std::invalid_argument При частотах вне [0, 1] или нулевой длине развертки.
+     */
+    ChirpGenerator(const std::string& nm, double amp, double f0, double f1, size_t sweepLength);
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+};
+
+/**
+ * @brief Цвет шума.
+ */
+enum class NoiseColor {
+    White, /**< Белый: равномерный спектр */
+    Pink   /**< Розовый: спектральная плотность ~ 1/f (-3 дБ на октаву) */
+};
+
+/**
+ * @brief Генератор гауссовского шума с воспроизводимым зерном.
+ * @details Равномерные числа — Xoshiro256 (4 потока), нормальные — преобразование
+ * Бокса — Мюллера над блоком. Розовый шум получается из белого фильтром П. Келлета
+ * (6 однополюсных звеньев, отклонение от -3 дБ/окт. не более 0.05 дБ выше 0.0004 fs)
+ * и нормируется к той же дисперсии; переходный процесс фильтра пропускается при reset.
+ * Одинаковое зерно дает одинаковый сигнал на любой платформе.
+ */
+class NoiseGenerator : public Generator {
+private:
+    double amplitude;              /**< Среднеквадратичное отклонение */
+    NoiseColor color;              /**< Цвет шума */
+    uint64_t seedValue;            /**< Зерно */
+    Xoshiro256 rng;                /**< Генератор равномерных чисел */
+    std::array<double, 7> pink;    /**< Состояние розового фильтра */
+
+    void whiteBlock(double* out);
+    void restart();
+
+protected:
+    void fillBlock(size_t start, double* out) override;
+
+public:
+    /**
+     * @brief Конструктор генератора шума.
+     * @param nm Имя блока.
+     * @param amp Среднеквадратичное отклонение.
+     * @param noiseColor Цвет шума.
+     * @param seed Зерно генератора.
+     */
+    NoiseGenerator(const std::string& nm, double amp, NoiseColor noiseColor, uint64_t seed);
+
+    /**
+     * @brief Возврат к началу последовательности (то же зерно — тот же сигнал).
+     */
+    void reset() override;
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+};
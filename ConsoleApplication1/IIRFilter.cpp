@@ -1,5 +1,6 @@
 #include "IIRFilter.h"
 #include <cassert>
+#include "Denormals.h"
 
 IIRFilter::IIRFilter(const std::string& nm,
     const std::vector<double>& bcoef,
@@ -10,20 +11,23 @@ IIRFilter::IIRFilter(const std::string& nm,
 }
 
 double IIRFilter::process(const std::vector<double>& inputs) {
-	assert(inputs.size() == 1); // фильтр принимает 1 вход
-	double x_t = inputs[0]; // текущее входное значение
+    assert(inputs.size() == 1); // фильтр принимает 1 вход
+    double x_t = inputs[0]; // текущее входное значение
 
     // обновляем буфер входов
     for (size_t i = xbuf.size() - 1; i > 0; --i)
         xbuf[i] = xbuf[i - 1];
-	xbuf[0] = x_t; // новое значение в буфере
+    xbuf[0] = x_t; // новое значение в буфере
 
     // вычисляем выход
-	double y = 0.0; // текущее выходное значение
+    double y = 0.0; // текущее выходное значение
     for (size_t i = 0; i < b.size(); ++i)
-		y += b[i] * xbuf[i]; // b[i] * x[t-i]
+        y += b[i] * xbuf[i]; // b[i] * x[t-i]
     for (size_t j = 0; j < a.size(); ++j)
-		y += a[j] * ybuf[j]; // a[j] * y[t-j]
+        y += a[j] * ybuf[j]; // a[j] * y[t-j]
+#ifdef DSP_DENORMAL_DC
+    if (!a.empty()) y += DSP_ANTI_DENORMAL; // обратная связь не затухает до денормализованных чисел
+#endif
 
     // обновляем буфер выходов
     for (size_t i = ybuf.size() - 1; i > 0; --i)
@@ -39,6 +43,21 @@ double IIRFilter::operator()(double x_t) {
 
 void IIRFilter::reset() {
     std::fill(xbuf.begin(), xbuf.end(), 0.0);
-	std::fill(ybuf.begin(), ybuf.end(), 0.0); // сброс буфера выходных значений
+    std::fill(ybuf.begin(), ybuf.end(), 0.0); // сброс буфера выходных значений
 }
 
+
+bool IIRFilter::getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const {
+    assert(inputs.size() == 1);
+    // y[t] = Σ b[i] * x[t-i] + Σ a[j] * y[t-1-j]  =>  A(z) = 1 - Σ a[j] * z^-(j+1)
+    std::vector<double> den(a.size() + 1, 0.0);
+    den[0] = 1.0;
+    for (size_t j = 0; j < a.size(); ++j)
+        den[j + 1] = -a[j];
+    out = inputs[0].cascade(TransferFunction{ b, den });
+    return true;
+}
+
+std::unique_ptr<Block> IIRFilter::clone() const {
+    return std::make_unique<IIRFilter>(*this);
+}
@@ -36,6 +36,20 @@ public:
      */
     void reset() override;
 
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+
+    /**
+     * @brief Передаточная функция блока с учетом передаточной функции его входа.
+     * @param inputs Передаточные функции входов. Ожидается размер, равный 1.
+     * @param out Передаточная функция выхода: H_in(z) * B(z) / (1 - Σ a[j] * z^-(j+1)).
+     * @return Всегда true: блок линейный.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override;
+
     /**
      * @brief Перегрузка оператора вызова функции "()".
      * @param x_t Одиночное входное значение.
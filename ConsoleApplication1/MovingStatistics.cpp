@@ -0,0 +1,260 @@
+#include "MovingStatistics.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+// ===== WindowSum =====
+
+void WindowSum::accumulate(double x) {
+    // суммирование Ноймайера: теряемые младшие разряды копятся в comp
+    double t = sum + x;
+    if (std::abs(sum) >= std::abs(x)) comp += (sum - t) + x;
+    else comp += (x - t) + sum;
+    sum = t;
+}
+
+void WindowSum::add(double x) {
+    if (std::isfinite(x)) accumulate(x);
+    else if (std::isnan(x)) ++nanCount;
+    else if (x > 0.0) ++posInfCount;
+    else ++negInfCount;
+}
+
+void WindowSum::remove(double x, const std::vector<double>& ring) {
+    if (std::isfinite(x)) {
+        accumulate(-x);
+        return;
+    }
+    if (std::isnan(x)) --nanCount;
+    else if (x > 0.0) --posInfCount;
+    else --negInfCount;
+    if (nanCount + posInfCount + negInfCount == 0) {
+        sum = 0.0;
+        comp = 0.0;
+        for (double v : ring) accumulate(v);
+    }
+}
+
+double WindowSum::value() const {
+    if (nanCount > 0 || (posInfCount > 0 && negInfCount > 0)) return std::numeric_limits<double>::quiet_NaN();
+    if (posInfCount > 0) return std::numeric_limits<double>::infinity();
+    if (negInfCount > 0) return -std::numeric_limits<double>::infinity();
+    return sum + comp;
+}
+
+void WindowSum::clear() {
+    sum = 0.0;
+    comp = 0.0;
+    nanCount = 0;
+    posInfCount = 0;
+    negInfCount = 0;
+}
+
+// ===== MovingAverage =====
+
+MovingAverage::MovingAverage(const std::string& nm, size_t windowLength)
+    : Block(nm), window(windowLength), pos(0) {
+    if (windowLength == 0) throw std::invalid_argument("Moving window length must be positive");
+    ring.assign(window, 0.0);
+}
+
+double MovingAverage::operator()(double x_t) {
+    double old = ring[pos];
+    ring[pos] = x_t;
+    if (++pos == window) pos = 0;
+    sum.add(x_t);
+    sum.remove(old, ring);
+    return sum.value() / static_cast<double>(window);
+}
+
+double MovingAverage::process(const std::vector<double>& inputs) {
+    assert(inputs.size() == 1); // блок принимает 1 вход
+    return (*this)(inputs[0]);
+}
+
+void MovingAverage::processBlock(const double* input, double* output, size_t n) {
+    for (size_t i = 0; i < n; ++i) output[i] = (*this)(input[i]);
+}
+
+void MovingAverage::reset() {
+    std::fill(ring.begin(), ring.end(), 0.0);
+    pos = 0;
+    sum.clear();
+}
+
+std::unique_ptr<Block> MovingAverage::clone() const {
+    return std::make_unique<MovingAverage>(*this);
+}
+
+bool MovingAverage::getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const {
+    assert(inputs.size() == 1);
+    out = inputs[0].cascade(TransferFunction{ std::vector<double>(window, 1.0 / window), { 1.0 } });
+    return true;
+}
+
+// ===== MovingRMS =====
+
+MovingRMS::MovingRMS(const std::string& nm, size_t windowLength)
+    : Block(nm), window(windowLength), pos(0) {
+    if (windowLength == 0) throw std::invalid_argument("Moving window length must be positive");
+    ring.assign(window, 0.0);
+}
+
+double MovingRMS::operator()(double x_t) {
+    double sq = x_t * x_t;
+    double old = ring[pos];
+    ring[pos] = sq;
+    if (++pos == window) pos = 0;
+    sum.add(sq);
+    sum.remove(old, ring);
+    double mean = sum.value() / static_cast<double>(window);
+    return mean < 0.0 ? 0.0 : std::sqrt(mean); // остаток округления может быть чуть меньше нуля; NaN сохраняется
+}
+
+double MovingRMS::process(const std::vector<double>& inputs) {
+    assert(inputs.size() == 1); // блок принимает 1 вход
+    return (*this)(inputs[0]);
+}
+
+void MovingRMS::processBlock(const double* input, double* output, size_t n) {
+    for (size_t i = 0; i < n; ++i) output[i] = (*this)(input[i]);
+}
+
+void MovingRMS::reset() {
+    std::fill(ring.begin(), ring.end(), 0.0);
+    pos = 0;
+    sum.clear();
+}
+
+std::unique_ptr<Block> MovingRMS::clone() const {
+    return std::make_unique<MovingRMS>(*this);
+}
+
+// ===== MovingExtremum =====
+
+MovingExtremum::MovingExtremum(const std::string& nm, size_t windowLength, bool maximum)
+    : Block(nm), window(windowLength), isMax(maximum), index(0) {
+    if (windowLength == 0) throw std::invalid_argument("Moving window length must be positive");
+}
+
+double MovingExtremum::operator()(double x_t) {
+    // с конца удаляются отсчеты, которые уже никогда не станут экстремумом
+    if (isMax) {
+        while (!queue.empty() && queue.back().second <= x_t) queue.pop_back();
+    }
+    else {
+        while (!queue.empty() && queue.back().second >= x_t) queue.pop_back();
+    }
+    queue.emplace_back(index, x_t);
+
+    // с начала — отсчет, вышедший из окна (index - window, index]
+    if (queue.front().first + window <= index) queue.pop_front();
+    ++index;
+    return queue.front().second;
+}
+
+double MovingExtremum::process(const std::vector<double>& inputs) {
+    assert(inputs.size() == 1); // блок принимает 1 вход
+    return (*this)(inputs[0]);
+}
+
+void MovingExtremum::processBlock(const double* input, double* output, size_t n) {
+    for (size_t i = 0; i < n; ++i) output[i] = (*this)(input[i]);
+}
+
+void MovingExtremum::reset() {
+    queue.clear();
+    index = 0;
+}
+
+std::unique_ptr<Block> MovingExtremum::clone() const {
+    return std::make_unique<MovingExtremum>(*this);
+}
+
+bool MovingExtremum::getHistoryLength(size_t& length) const {
+    // содержимое очереди в пределах окна определяется только отсчетами окна
+    length = window - 1;
+    return true;
+}
+
+// ===== MovingMedian =====
+
+MovingMedian::MovingMedian(const std::string& nm, size_t windowLength)
+    : Block(nm), window(windowLength), pos(0), count(0), nanCount(0) {
+    if (windowLength == 0) throw std::invalid_argument("Moving window length must be positive");
+    ring.assign(window, 0.0);
+}
+
+void MovingMedian::insert(double x) {
+    if (lower.empty() || x <= *lower.rbegin()) lower.insert(x);
+    else upper.insert(x);
+}
+
+void MovingMedian::rebalance() {
+    // узлы переносятся через extract, без перераспределения памяти
+    while (lower.size() > upper.size() + 1)
+        upper.insert(lower.extract(std::prev(lower.end())));
+    while (upper.size() > lower.size())
+        lower.insert(upper.extract(upper.begin()));
+}
+
+double MovingMedian::operator()(double x_t) {
+    // NaN не упорядочивается и в половины не попадает: такие отсчеты только считаются
+    const bool missing = std::isnan(x_t);
+    if (count == window) {
+        double old = ring[pos];
+        if (std::isnan(old)) {
+            --nanCount;
+            if (!missing) insert(x_t);
+        }
+        else {
+            // окно заполнено: узел выпавшего отсчета переиспользуется для нового
+            auto node = (old <= *lower.rbegin()) ? lower.extract(lower.find(old)) : upper.extract(upper.find(old));
+            if (!missing) {
+                node.value() = x_t;
+                // половина выбирается по состоянию после удаления, чтобы сохранить lower <= upper
+                bool toLower = lower.empty() ? (upper.empty() || x_t <= *upper.begin()) : x_t <= *lower.rbegin();
+                if (toLower) lower.insert(std::move(node));
+                else upper.insert(std::move(node));
+            }
+        }
+    }
+    else {
+        if (!missing) insert(x_t);
+        ++count;
+    }
+    if (missing) ++nanCount;
+    ring[pos] = x_t;
+    if (++pos == window) pos = 0;
+    rebalance();
+    assert(lower.size() + upper.size() + nanCount == count);
+
+    if (lower.empty()) return std::numeric_limits<double>::quiet_NaN(); // в окне только NaN
+    if (lower.size() > upper.size()) return *lower.rbegin();
+    return 0.5 * (*lower.rbegin() + *upper.begin());
+}
+
+double MovingMedian::process(const std::vector<double>& inputs) {
+    assert(inputs.size() == 1); // блок принимает 1 вход
+    return (*this)(inputs[0]);
+}
+
+void MovingMedian::processBlock(const double* input, double* output, size_t n) {
+    for (size_t i = 0; i < n; ++i) output[i] = (*this)(input[i]);
+}
+
+void MovingMedian::reset() {
+    std::fill(ring.begin(), ring.end(), 0.0);
+    pos = 0;
+    count = 0;
+    nanCount = 0;
+    lower.clear();
+    upper.clear();
+}
+
+std::unique_ptr<Block> MovingMedian::clone() const {
+    return std::make_unique<MovingMedian>(*this);
+}
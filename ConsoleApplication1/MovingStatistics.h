@@ -0,0 +1,327 @@
+#pragma once
+#include <deque>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include "Block.h"
+
+/**
+ * @brief Бегущая сумма отсчетов окна с компенсацией ошибок округления (алгоритм Ноймайера).
+ * @details Неконечные отсчеты (NaN, ±Inf) в сумму не входят — после NaN или Inf - Inf
+ * ее уже не восстановить вычитанием — и только считаются: пока они в окне, value()
+ * равно результату прямого сложения. Когда последний из них выходит из окна, сумма
+ * пересчитывается по содержимому окна.
+ */
+class WindowSum {
+private:
+    double sum = 0.0;          /**< Сумма конечных отсчетов */
+    double comp = 0.0;         /**< Компенсация ошибок округления суммы */
+    size_t nanCount = 0;       /**< Количество NaN в окне */
+    size_t posInfCount = 0;    /**< Количество +Inf в окне */
+    size_t negInfCount = 0;    /**< Количество -Inf в окне */
+
+    void accumulate(double x);
+
+public:
+    /** @brief Добавляет отсчет, вошедший в окно. */
+    void add(double x);
+
+    /**
+     * @brief Вычитает отсчет, вышедший из окна.
+     * @param x Выпавший отсчет.
+     * @param ring Отсчеты окна после замены (для пересчета суммы).
+     */
+    void remove(double x, const std::vector<double>& ring);
+
+    /** @brief Сумма отсчетов окна. */
+    double value() const;
+
+    /** @brief Обнуляет сумму и счетчики. */
+    void clear();
+};
+
+/**
+ * @brief Скользящее среднее по окну из N отсчетов за O(1) на отсчет.
+ * @details Эквивалентно FIRFilter с N коэффициентами 1/N (в начале сигнала недостающие
+ * отсчеты считаются нулями), но вместо N умножений поддерживает бегущую сумму:
+ * к ней добавляется новый отсчет и вычитается выпавший из окна. Сумма ведется
+ * с компенсацией ошибок округления (алгоритм Ноймайера), поэтому не «дрейфует»
+ * на длинных сигналах. NaN и ±Inf, как и у КИХ-фильтра, влияют на выход только
+ * N отсчетов (WindowSum).
+ */
+class MovingAverage : public Block {
+private:
+    size_t window;             /**< Длина окна N */
+    std::vector<double> ring;  /**< Последние N отсчетов */
+    size_t pos;                /**< Позиция самого старого отсчета в ring */
+    WindowSum sum;             /**< Бегущая сумма */
+
+public:
+    /**
+     * @brief Конструктор блока скользящего среднего.
+     * @param nm Имя блока.
+     * @param windowLength Длина окна (больше нуля).
+     * @throw std::invalid_argument Если длина окна равна нулю.
+     */
+    MovingAverage(const std::string& nm, size_t windowLength);
+
+    /**
+     * @brief Обработка одного отсчета.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 1.
+     * @return Среднее последних N отсчетов.
+     */
+    double process(const std::vector<double>& inputs) override;
+
+    /**
+     * @brief Блочная обработка без промежуточных векторов.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для выходных отсчетов (может совпадать с input).
+     * @param n Количество отсчетов.
+     */
+    void processBlock(const double* input, double* output, size_t n) override;
+
+    /**
+     * @brief Сброс окна и бегущей суммы.
+     */
+    void reset() override;
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+
+    /**
+     * @brief Передаточная функция: КИХ-фильтр с N коэффициентами 1/N.
+     * @param inputs Передаточные функции входов. Ожидается размер, равный 1.
+     * @param out Передаточная функция выхода.
+     * @return Всегда true: блок линейный.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override;
+
+    /**
+     * @brief Обработка одиночного значения.
+     * @param x_t Текущее значение входного сигнала.
+     * @return Среднее последних N отсчетов.
+     */
+    double operator()(double x_t);
+};
+
+/**
+ * @brief Скользящее среднеквадратичное значение по окну из N отсчетов за O(1) на отсчет.
+ * @details y[t] = sqrt(Σ x[t-i]^2 / N), i = 0 ... N-1; в начале сигнала недостающие отсчеты
+ * считаются нулями. Бегущая сумма квадратов ведется с компенсацией (алгоритм Ноймайера);
+ * NaN и ±Inf (в том числе переполнение квадрата) влияют на выход только N отсчетов.
+ */
+class MovingRMS : public Block {
+private:
+    size_t window;             /**< Длина окна N */
+    std::vector<double> ring;  /**< Квадраты последних N отсчетов */
+    size_t pos;                /**< Позиция самого старого отсчета в ring */
+    WindowSum sum;             /**< Бегущая сумма квадратов */
+
+public:
+    /**
+     * @brief Конструктор блока скользящего СКЗ.
+     * @param nm Имя блока.
+     * @param windowLength Длина окна (больше нуля).
+     * @throw std::invalid_argument Если длина окна равна нулю.
+     */
+    MovingRMS(const std::string& nm, size_t windowLength);
+
+    /**
+     * @brief Обработка одного отсчета.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 1.
+     * @return Среднеквадратичное значение последних N отсчетов.
+     */
+    double process(const std::vector<double>& inputs) override;
+
+    /**
+     * @brief Блочная обработка без промежуточных векторов.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для выходных отсчетов (может совпадать с input).
+     * @param n Количество отсчетов.
+     */
+    void processBlock(const double* input, double* output, size_t n) override;
+
+    /**
+     * @brief Сброс окна и бегущей суммы.
+     */
+    void reset() override;
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+
+    /**
+     * @brief Обработка одиночного значения.
+     * @param x_t Текущее значение входного сигнала.
+     * @return Среднеквадратичное значение последних N отсчетов.
+     */
+    double operator()(double x_t);
+};
+
+/**
+ * @brief Скользящий минимум или максимум по окну из N отсчетов за амортизированное O(1).
+ * @details Монотонная очередь хранит только отсчеты, которые еще могут стать экстремумом
+ * окна: новый отсчет вытесняет с конца все не лучшие его, а с начала удаляются отсчеты,
+ * вышедшие из окна. В начале сигнала окно содержит только уже полученные отсчеты.
+ */
+class MovingExtremum : public Block {
+private:
+    size_t window;                                /**< Длина окна N */
+    bool isMax;                                   /**< true — максимум, false — минимум */
+    std::deque<std::pair<size_t, double>> queue;  /**< Пары (номер отсчета, значение) */
+    size_t index;                                 /**< Номер текущего отсчета */
+
+protected:
+    /**
+     * @brief Конструктор блока скользящего экстремума.
+     * @param nm Имя блока.
+     * @param windowLength Длина окна (больше нуля).
+     * @param maximum true для максимума, false для минимума.
+     * @throw std::invalid_argument Если длина окна равна нулю.
+     */
+    MovingExtremum(const std::string& nm, size_t windowLength, bool maximum);
+
+public:
+    /**
+     * @brief Обработка одного отсчета.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 1.
+     * @return Экстремум последних N отсчетов.
+     */
+    double process(const std::vector<double>& inputs) override;
+
+    /**
+     * @brief Блочная обработка без промежуточных векторов.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для выходных отсчетов (может совпадать с input).
+     * @param n Количество отсчетов.
+     */
+    void processBlock(const double* input, double* output, size_t n) override;
+
+    /**
+     * @brief Сброс очереди.
+     */
+    void reset() override;
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+
+    /**
+     * @brief Память блока: экстремум зависит только от последних N отсчетов.
+     * @param length N - 1.
+     * @return Всегда true.
+     */
+    bool getHistoryLength(size_t& length) const override;
+
+    /**
+     * @brief Обработка одиночного значения.
+     * @param x_t Текущее значение входного сигнала.
+     * @return Экстремум последних N отсчетов.
+     */
+    double operator()(double x_t);
+};
+
+/**
+ * @brief Скользящий минимум по окну из N отсчетов.
+ */
+class MovingMin : public MovingExtremum {
+public:
+    /**
+     * @brief Конструктор блока скользящего минимума.
+     * @param nm Имя блока.
+     * @param windowLength Длина окна (больше нуля).
+     */
+    MovingMin(const std::string& nm, size_t windowLength) : MovingExtremum(nm, windowLength, false) {}
+
+    /** @brief Копия блока вместе с текущим состоянием. */
+    std::unique_ptr<Block> clone() const override { return std::make_unique<MovingMin>(*this); }
+};
+
+/**
+ * @brief Скользящий максимум по окну из N отсчетов.
+ */
+class MovingMax : public MovingExtremum {
+public:
+    /**
+     * @brief Конструктор блока скользящего максимума.
+     * @param nm Имя блока.
+     * @param windowLength Длина окна (больше нуля).
+     */
+    MovingMax(const std::string& nm, size_t windowLength) : MovingExtremum(nm, windowLength, true) {}
+
+    /** @brief Копия блока вместе с текущим состоянием. */
+    std::unique_ptr<Block> clone() const override { return std::make_unique<MovingMax>(*this); }
+};
+
+/**
+ * @brief Скользящая медиана по окну из N отсчетов за O(log N) на отсчет.
+ * @details Окно делится на две упорядоченные половины: нижнюю (lower) и верхнюю (upper),
+ * причем все элементы lower не больше элементов upper, а размер lower равен размеру upper
+ * или больше на единицу. Медиана — наибольший элемент lower (или среднее двух средних
+ * элементов при четном размере). Добавление и удаление отсчета — O(log N).
+ * В начале сигнала окно содержит только уже полученные отсчеты. Отсчеты NaN считаются
+ * пропущенными: медиана берется по остальным отсчетам окна, а если их нет — равна NaN.
+ */
+class MovingMedian : public Block {
+private:
+    size_t window;              /**< Длина окна N */
+    std::vector<double> ring;   /**< Последние N отсчетов (для удаления выпавших) */
+    size_t pos;                 /**< Позиция самого старого отсчета в ring */
+    size_t count;               /**< Количество отсчетов в окне (до N) */
+    size_t nanCount;            /**< Количество отсчетов NaN в окне (в половины не входят) */
+    std::multiset<double> lower; /**< Нижняя половина окна */
+    std::multiset<double> upper; /**< Верхняя половина окна */
+
+    void insert(double x);
+    void rebalance();
+
+public:
+    /**
+     * @brief Конструктор блока скользящей медианы.
+     * @param nm Имя блока.
+     * @param windowLength Длина окна (больше нуля).
+     * @throw std::invalid_argument Если длина окна равна нулю.
+     */
+    MovingMedian(const std::string& nm, size_t windowLength);
+
+    /**
+     * @brief Обработка одного отсчета.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 1.
+     * @return Медиана последних N отсчетов.
+     */
+    double process(const std::vector<double>& inputs) override;
+
+    /**
+     * @brief Блочная обработка без промежуточных векторов.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для выходных отсчетов (может совпадать с input).
+     * @param n Количество отсчетов.
+     */
+    void processBlock(const double* input, double* output, size_t n) override;
+
+    /**
+     * @brief Сброс окна.
+     */
+    void reset() override;
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+
+    /**
+     * @brief Обработка одиночного значения.
+     * @param x_t Текущее значение входного сигнала.
+     * @return Медиана последних N отсчетов.
+     */
+    double operator()(double x_t);
+};
@@ -1,10 +1,14 @@
 #pragma once
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 #include <string>
 #include <stdexcept>
+#include <algorithm>
 #include "Block.h"
+#include "Denormals.h"
+#include "ThreadPool.h"
 
 /**
  * @brief Система управления графом обработки сигналов.
@@ -20,6 +24,260 @@ private:
     /** @brief Таблица связей: ключ = блок-назначение, значение = список блоков-источников */
     std::unordered_map<std::string, std::vector<std::string>> connections;
 
+    /** @brief Число участков для параллельной обработки длинных сигналов (1 — последовательно) */
+    size_t processingThreads = 1;
+
+    /** @brief Наименьшая длина участка при параллельной обработке */
+    static constexpr size_t minSegment = 1 << 15;
+
+    /** @brief Поддерево без рекурсивного состояния: корень и память в отсчетах */
+    typedef std::pair<std::string, size_t> StatelessTree;
+
+    /** @brief Шаг скомпилированного плана вычислений */
+    struct PlanStep {
+        Block* block = nullptr;         /**< Вычисляемый блок */
+        bool external = false;          /**< Блок без связей: вход — внешний сигнал */
+        std::vector<size_t> sources;    /**< Номера шагов-источников входов */
+        std::vector<double> inputs;     /**< Входы блока (память выделяется один раз) */
+        const double* ready = nullptr;  /**< Готовые выходы блока по отсчетам (блок не вычисляется) */
+    };
+
+    /**
+     * @brief План вычисления выходов набора блоков.
+     * @details Шаги упорядочены топологически, поэтому каждый блок вычисляется ровно один раз
+     * за отсчет, даже если его выход нужен нескольким потребителям. Обход отсчета не обращается
+     * к таблицам имен.
+     */
+    struct Plan {
+        std::vector<PlanStep> steps;    /**< Шаги в порядке вычисления */
+        std::vector<size_t> outputs;    /**< Шаги, выходы которых запрошены */
+        std::vector<double> values;     /**< Выходы шагов на текущем отсчете */
+    };
+
+    /** @brief Планы последовательной обработки по имени выходного блока */
+    std::unordered_map<std::string, Plan> plans;
+
+    /** @brief Точки съема: блоки, выходы которых записывает processWithTaps */
+    std::vector<std::string> taps;
+
+    /** @brief План для точек съема */
+    Plan tapPlan;
+
+    /** @brief Признак актуальности tapPlan */
+    bool tapPlanValid = false;
+
+    /** @brief План computeAll: выходы всех блоков системы */
+    Plan allPlan;
+
+    /** @brief Имена блоков в порядке выходов allPlan */
+    std::vector<std::string> allNames;
+
+    /** @brief Выходы allPlan на последнем отсчете и указатели на них для runPlan */
+    std::vector<double> allValues;
+    std::vector<double*> allOutputs;
+
+    /** @brief Признак актуальности allPlan */
+    bool allPlanValid = false;
+
+    /**
+     * @brief Добавляет в план блок name и (раньше него) все его источники.
+     * @param index Уже добавленные блоки: имя -> номер шага.
+     * @param active Блоки на текущем пути обхода (для обнаружения циклов).
+     * @param ready Блоки с готовыми выходами: их источники в план не входят.
+     * @return Номер шага блока.
+     */
+    size_t addPlanStep(const std::string& name, Plan& plan,
+        std::unordered_map<std::string, size_t>& index, std::unordered_set<std::string>& active,
+        const std::unordered_map<std::string, const double*>& ready) const {
+        auto done = index.find(name);
+        if (done != index.end()) return done->second;
+        auto bit = blocks.find(name);
+        if (bit == blocks.end()) throw std::logic_error("Block not found: " + name);
+        if (!active.insert(name).second) throw std::logic_error("Connection cycle through block: " + name);
+
+        // источники обходятся в порядке, заданном connect
+        PlanStep step;
+        step.block = bit->second.get();
+        auto r = ready.find(name);
+        auto it = connections.find(name);
+        if (r != ready.end()) {
+            step.ready = r->second;
+        }
+        else {
+            step.external = (it == connections.end());
+            if (!step.external) {
+                for (const auto& src : it->second)
+                    step.sources.push_back(addPlanStep(src, plan, index, active, ready));
+            }
+            step.inputs.assign(step.external ? 1 : step.sources.size(), 0.0);
+        }
+
+        active.erase(name);
+        size_t position = plan.steps.size();
+        plan.steps.push_back(std::move(step));
+        index.emplace(name, position);
+        return position;
+    }
+
+    /**
+     * @brief Компилирует план вычисления выходов блоков roots.
+     * @param ready Блоки, выходы которых берутся из готовых массивов (индекс — номер отсчета
+     * в вызове runPlan), а не вычисляются.
+     * @throw std::logic_error Если блок не найден или связи образуют цикл.
+     */
+    Plan compilePlan(const std::vector<std::string>& roots,
+        const std::unordered_map<std::string, const double*>& ready = {}) const {
+        Plan plan;
+        std::unordered_map<std::string, size_t> index;
+        std::unordered_set<std::string> active;
+        for (const auto& root : roots)
+            plan.outputs.push_back(addPlanStep(root, plan, index, active, ready));
+        plan.values.assign(plan.steps.size(), 0.0);
+        return plan;
+    }
+
+    /**
+     * @brief Выполняет план для n отсчетов: выход шага plan.outputs[k] пишется в outputs[k].
+     * @param input Внешний вход системы (nullptr — нулевой вход).
+     */
+    static void runPlan(Plan& plan, const double* input, double* const* outputs, size_t n) {
+        if (plan.steps.size() == 1 && plan.steps[0].external && input && plan.outputs.size() == 1) {
+            // единственный блок на внешнем входе — его блочный путь обработки
+            plan.steps[0].block->processBlock(input, outputs[0], n);
+            return;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            double x = input ? input[i] : 0.0;
+            for (size_t s = 0; s < plan.steps.size(); ++s) {
+                PlanStep& step = plan.steps[s];
+                if (step.ready) {
+                    plan.values[s] = step.ready[i];
+                    continue;
+                }
+                if (step.external) {
+                    step.inputs[0] = x;
+                }
+                else {
+                    for (size_t j = 0; j < step.sources.size(); ++j)
+                        step.inputs[j] = plan.values[step.sources[j]];
+                }
+                plan.values[s] = step.block->process(step.inputs);
+            }
+            for (size_t k = 0; k < plan.outputs.size(); ++k)
+                outputs[k][i] = plan.values[plan.outputs[k]];
+        }
+    }
+
+    /**
+     * @brief План последовательной обработки для выхода блока (компилируется при первом вызове).
+     */
+    Plan& planFor(const std::string& name) {
+        auto it = plans.find(name);
+        if (it == plans.end()) it = plans.emplace(name, compilePlan({ name })).first;
+        return it->second;
+    }
+
+    /**
+     * @brief Анализ дерева зависимостей блока для параллельной обработки.
+     * @details Для каждого блока вычисляется память — число входных отсчетов, от которых
+     * зависит его выход (память блока плюс наибольшая память источников). Если на пути есть
+     * блок с рекурсивным состоянием, в trees добавляются его источники с конечной памятью.
+     * @param name Имя блока.
+     * @param visited Уже встреченные блоки.
+     * @param trees [out] Корни поддеревьев с конечной памятью, питающие блоки с состоянием.
+     * @param stateless [out] true, если память дерева блока конечна.
+     * @param memory [out] Память дерева блока (при stateless == true).
+     * @return false, если блок встречается в графе повторно (граф — не дерево).
+     */
+    bool analyzeTree(const std::string& name, std::unordered_set<std::string>& visited,
+        std::vector<StatelessTree>& trees, bool& stateless, size_t& memory) const {
+        if (!visited.insert(name).second) return false;
+        auto bit = blocks.find(name);
+        if (bit == blocks.end()) throw std::logic_error("Block not found: " + name);
+
+        std::vector<StatelessTree> sources;
+        bool sourcesStateless = true;
+        size_t sourceMemory = 0;
+        auto it = connections.find(name);
+        if (it != connections.end()) {
+            for (const auto& src : it->second) {
+                bool srcStateless;
+                size_t srcMemory;
+                if (!analyzeTree(src, visited, trees, srcStateless, srcMemory)) return false;
+                if (srcStateless) {
+                    sources.emplace_back(src, srcMemory);
+                    sourceMemory = std::max(sourceMemory, srcMemory);
+                }
+                else {
+                    sourcesStateless = false;
+                }
+            }
+        }
+
+        size_t own;
+        stateless = sourcesStateless && bit->second->getHistoryLength(own);
+        if (stateless) {
+            memory = own + sourceMemory;
+        }
+        else {
+            // граница: источники с конечной памятью считаются параллельно
+            trees.insert(trees.end(), sources.begin(), sources.end());
+        }
+        return true;
+    }
+
+    /**
+     * @brief Последовательная обработка массива отсчетов на выходе блока.
+     */
+    void processSerial(const std::string& name, const double* input, double* output, size_t n) {
+        double* outputs[] = { output };
+        runPlan(planFor(name), input, outputs, n);
+    }
+
+    /**
+     * @brief Параллельный расчет выходов поддеревьев с конечной памятью.
+     * @details Сигнал делится на участки. Первый участок обрабатывает сама система (с ее
+     * текущим состоянием); остальные — копии из copies, сброшенные и прогретые memory
+     * предшествующими отсчетами, поэтому результат побитно совпадает с последовательным.
+     * Затем система прогревается последними memory отсчетами, чтобы ее состояние после
+     * вызова было таким же, как при последовательной обработке.
+     */
+    void processTrees(const std::vector<StatelessTree>& trees, const std::vector<double*>& outputs,
+        const double* input, size_t n, std::vector<std::unique_ptr<ProcessingSystem>>& copies) {
+        size_t maxMemory = 0;
+        for (const auto& t : trees) maxMemory = std::max(maxMemory, t.second);
+        // прогрев занимает не больше 1/8 участка
+        size_t segLimit = std::max(minSegment, 8 * maxMemory);
+        size_t segments = std::max<size_t>(1, std::min(processingThreads, n / segLimit));
+        size_t segLen = (n + segments - 1) / segments;
+        // планы компилируются до запуска задач: задачи только читают таблицу планов
+        for (const auto& t : trees) {
+            planFor(t.first);
+            for (auto& c : copies) c->planFor(t.first);
+        }
+
+        ThreadPool::shared().parallelFor(trees.size() * segments, [&](size_t task, size_t worker) {
+            const std::string& root = trees[task / segments].first;
+            size_t memory = trees[task / segments].second;
+            double* out = outputs[task / segments];
+            size_t begin = (task % segments) * segLen;
+            size_t end = std::min(n, begin + segLen);
+            if (begin >= end) return;
+
+            std::vector<double> warm(memory);
+            if (begin == 0) {
+                processSerial(root, input, out, end);
+                size_t from = std::max(end, n - std::min(n, memory));
+                processSerial(root, input + from, warm.data(), n - from);
+                return;
+            }
+            ProcessingSystem& copy = *copies[worker];
+            copy.resetAll();
+            copy.processSerial(root, input + begin - memory, warm.data(), memory);
+            copy.processSerial(root, input + begin, out + begin, end - begin);
+        }, copies.size());
+    }
+
 public:
     /**
      * @brief Конструктор по умолчанию.
@@ -37,6 +295,7 @@ public:
         if (blocks.find(name) != blocks.end())
             throw std::logic_error("Block already exists: " + name);
         blocks.emplace(name, std::move(block));
+        allPlanValid = false;
     }
 
     /**
@@ -54,6 +313,32 @@ public:
                 throw std::logic_error("Source block not found: " + src);
 
         connections[outputBlock] = sourceBlocks;
+        plans.clear();
+        tapPlanValid = false;
+        allPlanValid = false;
+    }
+
+    /**
+     * @brief Создает независимую копию системы: те же блоки, связи и текущее состояние.
+     * @details Копии используются для параллельной обработки: каждый рабочий поток
+     * работает со своей копией, поэтому состояние фильтров не разделяется между потоками.
+     * @return Новая система.
+     * @throw std::logic_error Если какой-либо блок не поддерживает копирование.
+     */
+    std::unique_ptr<ProcessingSystem> clone() const {
+        auto copy = std::make_unique<ProcessingSystem>();
+        std::unordered_map<const Block*, Block*> map;
+        for (const auto& pair : blocks) {
+            std::unique_ptr<Block> b = pair.second->clone();
+            if (!b) throw std::logic_error("Block cannot be cloned: " + pair.first);
+            map[pair.second.get()] = b.get();
+            copy->blocks.emplace(pair.first, std::move(b));
+        }
+        copy->connections = connections;
+        copy->taps = taps;
+        for (auto& pair : copy->blocks)
+            pair.second->remapLinks(map);
+        return copy;
     }
 
     /**
@@ -67,46 +352,224 @@ public:
     }
 
     /**
-     * @brief Рекурсивный расчет выхода конкретного блока с учетом всех его зависимостей.
+     * @brief Проверяет, зарегистрирован ли в системе блок с таким именем.
+     * @param name Имя блока.
+     * @return true, если блок найден.
+     */
+    bool hasBlock(const std::string& name) const {
+        return blocks.find(name) != blocks.end();
+    }
+
+    /**
+     * @brief Расчет выхода конкретного блока с учетом всех его зависимостей.
+     * @details Каждый блок на пути к name вычисляется один раз, даже если его выход
+     * используется несколькими блоками.
      * @param name Имя блока, выход которого нужно вычислить.
      * @param input Значение внешнего входного сигнала системы.
      * @return Вычисленное выходное значение указанного блока.
-     * @throw std::logic_error Если блок не найден в системе.
+     * @throw std::logic_error Если блок не найден в системе или связи образуют цикл.
      */
     double computeBlock(const std::string& name, double input) {
+        double output;
+        processSerial(name, &input, &output, 1);
+        return output;
+    }
+
+    /**
+     * @brief Обработка массива отсчетов на выходе указанного блока.
+     * @details Если блок получает внешний вход напрямую (не имеет связей), используется
+     * его блочный путь обработки Block::processBlock; иначе граф обходится по отсчетам
+     * по скомпилированному плану, и каждый блок вычисляется один раз за отсчет.
+     *
+     * При setProcessingThreads > 1 длинные сигналы обрабатываются параллельно: части графа
+     * с конечной памятью (КИХ-фильтры, сумматоры, скользящие min/max) делятся на участки
+     * с перекрытием, блоки с рекурсивным состоянием (БИХ-фильтры и т.п.) считаются
+     * последовательно по уже готовым выходам своих источников. Результат и состояние
+     * системы после вызова побитно совпадают с последовательной обработкой. Если блок
+     * встречается в дереве зависимостей дважды, используется последовательный путь.
+     *
+     * На время вызова включается сброс денормализованных чисел (ScopedFlushDenormals).
+     * @param name Имя блока, выход которого нужно вычислить.
+     * @param input Массив входных отсчетов системы.
+     * @param output Массив для выходных отсчетов.
+     * @param n Количество отсчетов.
+     * @throw std::logic_error Если блок не найден в системе или не поддерживает копирование.
+     */
+    void processSignal(const std::string& name, const double* input, double* output, size_t n) {
+        ScopedFlushDenormals flushDenormals;
+        if (processingThreads < 2 || n < 2 * minSegment) {
+            processSerial(name, input, output, n);
+            return;
+        }
+
+        std::unordered_set<std::string> visited;
+        std::vector<StatelessTree> trees;
+        bool stateless;
+        size_t memory = 0;
+        if (!analyzeTree(name, visited, trees, stateless, memory)) {
+            processSerial(name, input, output, n);
+            return;
+        }
+        if (stateless) {
+            trees.assign(1, StatelessTree(name, memory));
+        }
+        if (trees.empty()) {
+            processSerial(name, input, output, n);
+            return;
+        }
+
+        // копии создаются до запуска задач: во время обработки система изменяется
+        std::vector<std::unique_ptr<ProcessingSystem>> copies(
+            std::min(processingThreads, ThreadPool::shared().size()));
+        for (auto& c : copies) c = clone();
+
+        if (stateless) {
+            processTrees(trees, { output }, input, n, copies);
+            return;
+        }
+
+        // выходы поддеревьев считаются порциями, остальной граф — последовательно по ним,
+        // по плану, шаги которого для корней поддеревьев читают готовые буферы
+        size_t chunk = std::min(n, 4 * processingThreads * minSegment);
+        std::vector<std::vector<double>> buffers(trees.size(), std::vector<double>(chunk));
+        std::vector<double*> outputs;
+        std::unordered_map<std::string, const double*> ready;
+        for (size_t k = 0; k < trees.size(); ++k) {
+            outputs.push_back(buffers[k].data());
+            ready[trees[k].first] = buffers[k].data();
+        }
+        Plan rest = compilePlan({ name }, ready);
+        for (size_t pos = 0; pos < n; pos += chunk) {
+            size_t len = std::min(chunk, n - pos);
+            processTrees(trees, outputs, input + pos, len, copies);
+            double* out[] = { output + pos };
+            runPlan(rest, input + pos, out, len);
+        }
+    }
+
+    /**
+     * @brief Задает число участков для параллельной обработки длинных сигналов.
+     * @param threads Число участков (потоков); 0 — по числу потоков общего пула, 1 — последовательно.
+     */
+    void setProcessingThreads(size_t threads) {
+        processingThreads = (threads == 0) ? ThreadPool::shared().size() : threads;
+    }
+
+    /**
+     * @brief Текущее число участков для параллельной обработки.
+     * @return Значение, заданное setProcessingThreads (1 по умолчанию).
+     */
+    size_t getProcessingThreads() const { return processingThreads; }
+
+    /**
+     * @brief Рекурсивно строит передаточную функцию от внешнего входа системы к выходу блока.
+     * @details Повторяет порядок обхода computeBlock, но вместо отсчетов комбинирует
+     * передаточные функции источников. Состояние блоков не изменяется.
+     * @param name Имя блока, для выхода которого строится передаточная функция.
+     * @return Передаточная функция H(z) = B(z) / A(z).
+     * @throw std::logic_error Если блок не найден или на пути к нему есть нелинейный блок.
+     */
+    TransferFunction getTransferFunction(const std::string& name) const {
         auto it = connections.find(name);
-        std::vector<double> inputs;
+        std::vector<TransferFunction> inputs;
 
         if (it != connections.end()) {
-            // Блок зависит от других блоков
             for (const auto& src : it->second) {
-                inputs.push_back(computeBlock(src, input));
+                inputs.push_back(getTransferFunction(src));
             }
         }
         else {
-            // Нет зависимостей — используем внешний входной сигнал
-            inputs.push_back(input);
+            // Нет зависимостей — вход блока совпадает с внешним входом системы
+            inputs.push_back(TransferFunction::identity());
         }
 
-        Block* b = getBlock(name);
-        if (!b) throw std::logic_error("Block not found: " + name);
-        return b->process(inputs);
+        auto bit = blocks.find(name);
+        if (bit == blocks.end()) throw std::logic_error("Block not found: " + name);
+
+        TransferFunction out;
+        if (!bit->second->getTransferFunction(inputs, out))
+            throw std::logic_error("Block has no transfer function: " + name);
+        return out;
     }
 
     /**
      * @brief Вычисляет выходы абсолютно всех блоков системы для одного входа.
+     * @details Каждый блок вычисляется (и продвигается) ровно один раз. План по всем блокам
+     * компилируется при первом вызове (до изменения блоков или связей). Для обработки
+     * сигналов с несколькими выходами удобнее точки съема (addTap, processWithTaps).
      * @param input Значение внешнего входного сигнала.
      * @return Хеш-таблица (словарь), где ключ — имя блока, а значение — его выход.
      */
     std::unordered_map<std::string, double> computeAll(double input) {
-        std::unordered_map<std::string, double> results;
-        for (const auto& pair : blocks) {
-            const std::string& name = pair.first;
-            results[name] = computeBlock(name, input);
+        if (!allPlanValid) {
+            allNames.clear();
+            for (const auto& pair : blocks) allNames.push_back(pair.first);
+            allPlan = compilePlan(allNames);
+            allValues.assign(allNames.size(), 0.0);
+            allOutputs.clear();
+            for (double& v : allValues) allOutputs.push_back(&v);
+            allPlanValid = true;
         }
+        runPlan(allPlan, &input, allOutputs.data(), 1);
+
+        std::unordered_map<std::string, double> results;
+        for (size_t k = 0; k < allNames.size(); ++k) results[allNames[k]] = allValues[k];
         return results;
     }
 
+    /**
+     * @brief Регистрирует точку съема — блок, выход которого записывает processWithTaps.
+     * @param name Имя блока.
+     * @return Номер точки съема (номер выходного буфера в processWithTaps). Повторная
+     * регистрация того же блока возвращает прежний номер.
+     * @throw std::logic_error Если блок не найден.
+     */
+    size_t addTap(const std::string& name) {
+        if (blocks.find(name) == blocks.end()) throw std::logic_error("Block not found: " + name);
+        auto it = std::find(taps.begin(), taps.end(), name);
+        if (it != taps.end()) return static_cast<size_t>(it - taps.begin());
+        taps.push_back(name);
+        tapPlanValid = false;
+        return taps.size() - 1;
+    }
+
+    /**
+     * @brief Удаляет все точки съема.
+     */
+    void clearTaps() {
+        taps.clear();
+        tapPlanValid = false;
+    }
+
+    /**
+     * @brief Количество зарегистрированных точек съема.
+     * @return Число точек съема.
+     */
+    size_t getTapCount() const { return taps.size(); }
+
+    /**
+     * @brief Обрабатывает сигнал за один проход, записывая выходы всех точек съема.
+     * @details План вычислений компилируется один раз (до изменения связей или точек съема).
+     * Блоки, общие для нескольких точек, вычисляются один раз за отсчет: каждый блок, от
+     * которого зависит хотя бы одна точка съема, продвигается на n отсчетов и после вызова
+     * находится в том же состоянии, что и после processSignal для этой точки. Блоки, от
+     * которых не зависит ни одна точка, не изменяются.
+     * На время вызова включается сброс денормализованных чисел (ScopedFlushDenormals).
+     * @param input Массив входных отсчетов системы (nullptr — нулевой вход, например для
+     * графов с генераторами).
+     * @param outputs Массив из getTapCount() указателей на буферы длины n (в порядке addTap).
+     * @param n Количество отсчетов.
+     * @throw std::logic_error Если связи образуют цикл.
+     */
+    void processWithTaps(const double* input, double* const* outputs, size_t n) {
+        ScopedFlushDenormals flushDenormals;
+        if (!tapPlanValid) {
+            tapPlan = compilePlan(taps);
+            tapPlanValid = true;
+        }
+        runPlan(tapPlan, input, outputs, n);
+    }
+
     /**
      * @brief Сбрасывает внутреннее состояние (буферы, память) всех блоков в системе.
      */
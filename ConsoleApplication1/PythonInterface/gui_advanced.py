@@ -26,13 +26,15 @@ def to_c_double_array(lst):
     """
     return (ctypes.c_double * len(lst))(*lst)
 
+DSP_NOISE_WHITE = 0
+
 # --- 1. БЕЗОПАСНАЯ ЗАГРУЗКА DLL ---
 lib = None
 
 # Проверяем, не читает ли нас сейчас Sphinx
 if os.environ.get('SPHINX_BUILD') != '1':
     
-    dll_name = "ConsoleApplication1.dll"
+    dll_name = "ConsoleApplication1.dll" if os.name == "nt" else "libdspfilter.so"
     if not os.path.exists(dll_name):
         messagebox.showerror("Ошибка", f"Файл {dll_name} не найден!")
         exit(1)
@@ -54,6 +56,26 @@ if os.environ.get('SPHINX_BUILD') != '1':
     ]
     lib.processSignal.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_double), ctypes.POINTER(ctypes.c_double), ctypes.c_int]
 
+    # Асинхронная обработка (есть в новых версиях библиотеки)
+    if hasattr(lib, 'submitProcess'):
+        lib.submitProcess.argtypes = [
+            ctypes.c_void_p, ctypes.c_char_p,
+            ctypes.POINTER(ctypes.c_double), ctypes.POINTER(ctypes.c_double), ctypes.c_int,
+            ctypes.c_void_p, ctypes.c_void_p
+        ]
+        lib.submitProcess.restype = ctypes.c_longlong
+        lib.pollCompletion.argtypes = [ctypes.POINTER(ctypes.c_longlong), ctypes.POINTER(ctypes.c_int), ctypes.c_void_p]
+        lib.pollCompletion.restype = ctypes.c_int
+
+    # Генераторы сигналов (есть в новых версиях библиотеки)
+    if hasattr(lib, 'generateSignal'):
+        lib.addSineGenerator.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_double, ctypes.c_double, ctypes.c_double]
+        lib.addSquareGenerator.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_double, ctypes.c_double, ctypes.c_double]
+        lib.addNoiseGenerator.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_double, ctypes.c_ulonglong]
+        lib.addSummator.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_double, ctypes.c_double]
+        lib.connect.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int]
+        lib.generateSignal.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_double), ctypes.c_int]
+
     try:
         lib.getLastError.restype = ctypes.c_char_p
     except AttributeError:
@@ -91,6 +113,7 @@ class SignalApp:
         self.signal_type_var = tk.StringVar(value="Синус + Шум")
         self.filter_type_var = tk.StringVar(value="FIR (Скользящее среднее)")
         
+        self.pending = None  # незавершенное асинхронное задание и его буферы
         self.setup_ui()
         self.system = lib.createSystem()
 
@@ -120,9 +143,11 @@ class SignalApp:
         """
         Основной метод обработки, вызываемый при нажатии кнопки в интерфейсе.
 
-        Выполняет генерацию входного массива данных в зависимости от выбора пользователя, 
+        Выполняет генерацию входного массива данных в зависимости от выбора пользователя (generate_input), 
         настраивает выбранный фильтр в C++ системе (КИХ или БИХ), 
         пропускает массив через DLL и обновляет график Matplotlib результатами.
+        Если библиотека поддерживает submitProcess, обработка идет в фоне, а результат
+        забирается опросом (poll_result), поэтому окно не зависает на больших сигналах.
 
         :raises Exception: Перехватывает ошибки от DLL и показывает их пользователю в диалоговом окне.
         """
@@ -141,25 +166,23 @@ class SignalApp:
                 lib.addIIR(self.system, b"MyFilter", to_c_double_array(b_coeffs), len(b_coeffs), to_c_double_array(a_coeffs), len(a_coeffs))
 
             N = 200
-            input_data = []
             sig_type = self.signal_type_var.get()
-            
-            for i in range(N):
-                noise = random.uniform(-2.0, 2.0)
-                if "Синус" in sig_type:
-                    val = math.sin(i * 0.1) * 5.0 + noise
-                elif "Меандр" in sig_type:
-                    val = 5.0 if (i // 20) % 2 == 0 else -5.0
-                    val += noise
-                else:
-                    val = noise
-                input_data.append(val)
+            c_input = self.generate_input(sig_type, N)
+            input_data = list(c_input)
 
-            c_input = to_c_double_array(input_data)
             output_data = [0.0] * N
             c_output = to_c_double_array(output_data)
 
-            if hasattr(lib, 'processSignal'):
+            if hasattr(lib, 'submitProcess'):
+                job_id = lib.submitProcess(self.system, b"MyFilter", c_input, c_output, N, None, None)
+                if job_id <= 0:
+                    check_for_error()
+                    raise Exception("Очередь обработки заполнена, повторите позже")
+                # буферы должны жить до завершения задания
+                self.pending = (job_id, input_data, c_input, c_output, filt_type, sig_type)
+                self.root.after(20, self.poll_result)
+                return
+            elif hasattr(lib, 'processSignal'):
                 lib.processSignal(self.system, b"MyFilter", c_input, c_output, N)
                 check_for_error()
             else:
@@ -172,18 +195,93 @@ class SignalApp:
                     c_output[i] = lib.computeBlock(self.system, b"MyFilter", ctypes.c_double(input_data[i]))
                     check_for_error()
 
-            # Визуализация
-            self.ax.clear()
-            self.ax.plot(input_data, label='Вход', color='#CCCCCC', linestyle='--')
-            self.ax.plot(list(c_output), label='Выход', color='#FF5722', linewidth=2)
-            self.ax.set_title(f"Результат: {filt_type} | Сигнал: {sig_type}")
-            self.ax.legend()
-            self.ax.grid(True, linestyle=':', alpha=0.6)
-            self.canvas.draw()
+            self.show_result(input_data, list(c_output), filt_type, sig_type)
 
         except Exception as e:
             messagebox.showerror("Ошибка выполнения", f"Внутренняя ошибка библиотеки:\n{e}")
 
+    def generate_input(self, sig_type, n):
+        """
+        Синтезирует входной сигнал выбранного типа (синус, меандр с периодом 40 отсчетов
+        или только шум) с шумом уровня 2.
+
+        Если библиотека поддерживает генераторы, сигнал создается в C++ блоками-генераторами
+        текущей системы, иначе — в Python. Равномерный шум [-2, 2] заменяется гауссовским
+        с той же дисперсией.
+
+        :param sig_type: Название сигнала из списка.
+        :param n: Количество отсчетов.
+        :return: Массив ctypes.c_double длины n.
+        """
+        if hasattr(lib, 'generateSignal'):
+            lib.addNoiseGenerator(self.system, b"Noise", DSP_NOISE_WHITE, 2.0 / math.sqrt(3.0), random.getrandbits(64))
+            source = b"Noise"
+            if "Синус" in sig_type or "Меандр" in sig_type:
+                if "Синус" in sig_type:
+                    lib.addSineGenerator(self.system, b"Wave", 5.0, 0.1 / math.pi, 0.0)
+                else:
+                    lib.addSquareGenerator(self.system, b"Wave", 5.0, 0.05, 0.5)
+                lib.addSummator(self.system, b"Source", 1.0, 1.0)
+                lib.connect(self.system, b"Source", (ctypes.c_char_p * 2)(b"Wave", b"Noise"), 2)
+                source = b"Source"
+            c_input = (ctypes.c_double * n)()
+            lib.generateSignal(self.system, source, c_input, n)
+            check_for_error()
+            return c_input
+
+        input_data = []
+        for i in range(n):
+            noise = random.uniform(-2.0, 2.0)
+            if "Синус" in sig_type:
+                val = math.sin(i * 0.1) * 5.0 + noise
+            elif "Меандр" in sig_type:
+                val = 5.0 if (i // 20) % 2 == 0 else -5.0
+                val += noise
+            else:
+                val = noise
+            input_data.append(val)
+        return to_c_double_array(input_data)
+
+    def poll_result(self):
+        """
+        Опрашивает очередь завершений библиотеки (без ожидания) и выводит результат
+        асинхронного задания; если задание еще не готово, повторяет опрос позже.
+        """
+        if self.pending is None:
+            return
+        job_id = ctypes.c_longlong(0)
+        status = ctypes.c_int(0)
+        while lib.pollCompletion(ctypes.byref(job_id), ctypes.byref(status), None):
+            if job_id.value != self.pending[0]:
+                continue  # завершение устаревшего задания
+            _, input_data, _, c_output, filt_type, sig_type = self.pending
+            self.pending = None
+            if status.value != 0:
+                err = lib.getLastError()
+                messagebox.showerror("Ошибка выполнения",
+                                     f"Внутренняя ошибка библиотеки:\n{err.decode('utf-8') if err else ''}")
+            else:
+                self.show_result(input_data, list(c_output), filt_type, sig_type)
+            return
+        self.root.after(20, self.poll_result)
+
+    def show_result(self, input_data, output_data, filt_type, sig_type):
+        """
+        Перерисовывает график: входной сигнал и результат обработки.
+
+        :param input_data: Входные отсчеты.
+        :param output_data: Выходные отсчеты.
+        :param filt_type: Название фильтра (для заголовка).
+        :param sig_type: Название сигнала (для заголовка).
+        """
+        self.ax.clear()
+        self.ax.plot(input_data, label='Вход', color='#CCCCCC', linestyle='--')
+        self.ax.plot(output_data, label='Выход', color='#FF5722', linewidth=2)
+        self.ax.set_title(f"Результат: {filt_type} | Сигнал: {sig_type}")
+        self.ax.legend()
+        self.ax.grid(True, linestyle=':', alpha=0.6)
+        self.canvas.draw()
+
     def __del__(self):
         """
         Деструктор класса. Корректно очищает память системы в C++.
@@ -28,7 +28,7 @@ lib = None
 
 # Если мы НЕ собираем документацию Sphinx, пробуем загрузить DLL
 if os.environ.get('SPHINX_BUILD') != '1':
-    dll_name = "ConsoleApplication1.dll"
+    dll_name = "ConsoleApplication1.dll" if os.name == "nt" else "libdspfilter.so"
     dll_path = get_resource_path(dll_name)
 
     if not os.path.exists(dll_path):
@@ -49,6 +49,23 @@ if os.environ.get('SPHINX_BUILD') != '1':
                     ctypes.POINTER(ctypes.c_double), 
                     ctypes.POINTER(ctypes.c_double), ctypes.c_int
                 ]
+
+            # Генераторы сигналов (есть в новых версиях библиотеки)
+            if hasattr(lib, 'generateSignal'):
+                lib.addSineGenerator.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_double, ctypes.c_double, ctypes.c_double]
+                lib.addNoiseGenerator.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_double, ctypes.c_ulonglong]
+                lib.addSummator.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_double, ctypes.c_double]
+                lib.connect.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int]
+                lib.generateSignal.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_double), ctypes.c_int]
+
+            # Точки съема (есть в новых версиях библиотеки)
+            if hasattr(lib, 'processWithTaps'):
+                lib.addTap.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+                lib.addTap.restype = ctypes.c_int
+                lib.processWithTaps.argtypes = [
+                    ctypes.c_void_p, ctypes.POINTER(ctypes.c_double),
+                    ctypes.POINTER(ctypes.POINTER(ctypes.c_double)), ctypes.c_int
+                ]
         except Exception as e:
             print(f"Критическая ошибка загрузки DLL: {e}")
 
@@ -63,6 +80,47 @@ def to_c_double_array(data):
     """
     return (ctypes.c_double * len(data))(*data)
 
+DSP_NOISE_WHITE = 0
+
+def add_source(system, freq, noise_level):
+    """
+    Добавляет в систему блок "Source": синусоида 5 * sin(freq * i) плюс шум уровня noise_level,
+    собранные из генераторов библиотеки (синусоидальный генератор и белый шум, сумматор).
+    Равномерный шум [-noise_level, noise_level] заменяется гауссовским с той же дисперсией.
+
+    :param system: Указатель на систему C++.
+    :param freq: Частота синусоиды в радианах на отсчет.
+    :param noise_level: Уровень шума.
+    :return: True, если блоки добавлены; False, если библиотека не поддерживает генераторы
+             или частота выше частоты Найквиста.
+    """
+    if not hasattr(lib, 'generateSignal') or not 0.0 <= freq <= math.pi:
+        return False
+    lib.addSineGenerator(system, b"Sine", 5.0, freq / math.pi, 0.0)
+    lib.addNoiseGenerator(system, b"Noise", DSP_NOISE_WHITE, abs(noise_level) / math.sqrt(3.0), random.getrandbits(64))
+    lib.addSummator(system, b"Source", 1.0, 1.0)
+    lib.connect(system, b"Source", (ctypes.c_char_p * 2)(b"Sine", b"Noise"), 2)
+    return True
+
+def generate_input(system, n, freq, noise_level):
+    """
+    Синтезирует входной сигнал: синусоида 5 * sin(freq * i) плюс шум уровня noise_level.
+
+    Если библиотека поддерживает генераторы, сигнал создается в C++ (add_source)
+    без поотсчетных вычислений в Python.
+
+    :param system: Указатель на систему C++.
+    :param n: Количество отсчетов.
+    :param freq: Частота синусоиды в радианах на отсчет.
+    :param noise_level: Уровень шума.
+    :return: Массив ctypes.c_double длины n.
+    """
+    if add_source(system, freq, noise_level):
+        c_input = (ctypes.c_double * n)()
+        lib.generateSignal(system, b"Source", c_input, n)
+        return c_input
+    return to_c_double_array([math.sin(i * freq) * 5.0 + random.uniform(-noise_level, noise_level) for i in range(n)])
+
 
 # --- 2. КЛАСС ГРАФИЧЕСКОГО ИНТЕРФЕЙСА ---
 
@@ -126,7 +184,7 @@ class FilterApp:
         """
         Основной цикл обработки данных.
 
-        Считывает параметры из GUI, генерирует сигнал в Python,
+        Считывает параметры из GUI, генерирует сигнал (generate_input),
         вызывает функции C++ DLL для фильтрации и обновляет график.
 
         :raises ValueError: Если введены некорректные данные (не числа).
@@ -146,28 +204,35 @@ class FilterApp:
             coeffs_str = self.entry_coeffs.get()
             coeffs = [float(x.strip()) for x in coeffs_str.split(',')]
             
-            # 2. Генерация сигнала
+            # 2. Генерация сигнала и 3. взаимодействие с DLL
             N = 200
-            input_data = [math.sin(i * freq) * 5.0 + random.uniform(-noise_level, noise_level) for i in range(N)]
-            
-            # 3. Взаимодействие с DLL
             system = lib.createSystem()
-            
             c_coeffs = to_c_double_array(coeffs)
             lib.addFIR(system, b"UserFilter", c_coeffs, len(coeffs))
             
-            c_input = to_c_double_array(input_data)
             output_data = [0.0] * N
             c_output = to_c_double_array(output_data)
             
-            if hasattr(lib, 'processSignal'):
-                lib.processSignal(system, b"UserFilter", c_input, c_output, N)
+            if hasattr(lib, 'processWithTaps') and add_source(system, freq, noise_level):
+                # вход и выход фильтра за один проход: точки съема на источнике и на фильтре
+                lib.connect(system, b"UserFilter", (ctypes.c_char_p * 1)(b"Source"), 1)
+                lib.addTap(system, b"Source")
+                lib.addTap(system, b"UserFilter")
+                c_input = (ctypes.c_double * N)()
+                buffers = (ctypes.POINTER(ctypes.c_double) * 2)(c_input, c_output)
+                lib.processWithTaps(system, None, buffers, N)
+                input_data = list(c_input)
             else:
-                # Резервный метод поотсчетной обработки
-                lib.computeBlock.restype = ctypes.c_double
-                lib.resetAll(system)
-                for i in range(N):
-                    c_output[i] = lib.computeBlock(system, b"UserFilter", ctypes.c_double(input_data[i]))
+                c_input = generate_input(system, N, freq, noise_level)
+                input_data = list(c_input)
+                if hasattr(lib, 'processSignal'):
+                    lib.processSignal(system, b"UserFilter", c_input, c_output, N)
+                else:
+                    # Резервный метод поотсчетной обработки
+                    lib.computeBlock.restype = ctypes.c_double
+                    lib.resetAll(system)
+                    for i in range(N):
+                        c_output[i] = lib.computeBlock(system, b"UserFilter", ctypes.c_double(input_data[i]))
             
             lib.destroySystem(system)
             
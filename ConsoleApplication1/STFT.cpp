@@ -0,0 +1,183 @@
+#include "STFT.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+STFT::STFT(const std::string& nm, WindowType windowType, size_t windowLength, size_t hop, size_t nfft,
+    SpectrumScale scale)
+    : Block(nm), windowLength(windowLength), hop(hop), nfft(nfft), scale(scale),
+      pos(0), untilFrame(windowLength), frameCount(0),
+      outBuffer(nullptr), maxFrames(0), inverse(nullptr) {
+    if (windowLength == 0 || windowLength > nfft)
+        throw std::invalid_argument("STFT window length must be in [1, nfft]");
+    if (hop == 0 || hop > windowLength)
+        throw std::invalid_argument("STFT hop must be in [1, window length]");
+
+    // периодическое окно: сумма сдвинутых копий постоянна, что важно для синтеза
+    window = Window::generate(windowType, windowLength, 8.6, true);
+    plan = FFTPlan::get(nfft);
+    ring.assign(windowLength, 0.0);
+    work.resize(nfft);
+    values.resize(getBinCount());
+}
+
+double STFT::process(const std::vector<double>& inputs) {
+    assert(inputs.size() == 1); // блок принимает 1 вход
+    double x = inputs[0];
+
+    ring[pos] = x;
+    pos = (pos + 1 == windowLength) ? 0 : pos + 1;
+
+    if (--untilFrame == 0) {
+        emitFrame();
+        untilFrame = hop;
+    }
+    return x; // сигнал проходит без изменений
+}
+
+void STFT::emitFrame() {
+    // кадр из последних windowLength отсчетов: самый старый находится в ring[pos]
+    size_t tail = windowLength - pos;
+    for (size_t i = 0; i < tail; ++i)
+        work[i] = ring[pos + i] * window[i];
+    for (size_t i = tail; i < windowLength; ++i)
+        work[i] = ring[i - tail] * window[i];
+    std::fill(work.begin() + windowLength, work.end(), std::complex<double>(0.0, 0.0));
+
+    plan->forward(work.data());
+
+    size_t nBins = getBinCount();
+    size_t index = frameCount++;
+
+    for (size_t k = 0; k < nBins; ++k) {
+        double p = std::norm(work[k]);
+        switch (scale) {
+        case SpectrumScale::Magnitude: values[k] = std::sqrt(p); break;
+        case SpectrumScale::Power: values[k] = p; break;
+        case SpectrumScale::Decibel: values[k] = 10.0 * std::log10(std::max(p, 1e-30)); break;
+        }
+    }
+
+    // строки буфера — частоты, столбцы — кадры (по кругу)
+    if (outBuffer && maxFrames > 0) {
+        size_t column = index % maxFrames;
+        for (size_t k = 0; k < nBins; ++k)
+            outBuffer[k * maxFrames + column] = values[k];
+    }
+    if (frameCallback) frameCallback(values.data(), nBins, index);
+
+    // спектральная обработка влияет только на синтез, спектрограмма показывает исходный спектр
+    if (spectrumCallback) spectrumCallback(work.data(), nBins, index);
+    if (inverse) inverse->pushFrame(work.data());
+}
+
+void STFT::reset() {
+    std::fill(ring.begin(), ring.end(), 0.0);
+    pos = 0;
+    untilFrame = windowLength;
+    frameCount = 0;
+}
+
+std::unique_ptr<Block> STFT::clone() const {
+    auto copy = std::make_unique<STFT>(*this);
+    // приемники кадров принадлежат исходному блоку
+    copy->outBuffer = nullptr;
+    copy->maxFrames = 0;
+    copy->frameCallback = nullptr;
+    return copy;
+}
+
+void STFT::remapLinks(const std::unordered_map<const Block*, Block*>& map) {
+    if (!inverse) return;
+    auto it = map.find(inverse);
+    inverse = (it != map.end()) ? static_cast<ISTFT*>(it->second) : nullptr;
+}
+
+bool STFT::getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const {
+    assert(inputs.size() == 1);
+    out = inputs[0]; // H(z) = 1
+    return true;
+}
+
+void STFT::setOutputBuffer(double* buffer, size_t frames) {
+    outBuffer = buffer;
+    maxFrames = buffer ? frames : 0;
+}
+
+void STFT::setFrameCallback(FrameCallback cb) {
+    frameCallback = std::move(cb);
+}
+
+void STFT::setSpectrumCallback(SpectrumCallback cb) {
+    spectrumCallback = std::move(cb);
+}
+
+void STFT::attachInverse(ISTFT* inv) {
+    inverse = inv;
+}
+
+ISTFT::ISTFT(const std::string& nm, const STFT& analysis)
+    : Block(nm), windowLength(analysis.getWindowLength()), hop(analysis.getHop()),
+      nfft(analysis.getFFTSize()), window(analysis.getWindow()),
+      fifoHead(0), fifoSize(0) {
+    plan = FFTPlan::get(nfft);
+    accum.assign(windowLength, 0.0);
+    norm.assign(windowLength, 0.0);
+    fifo.assign(2 * hop, 0.0);
+    work.resize(nfft);
+}
+
+void ISTFT::pushFrame(const std::complex<double>* spectrum) {
+    // восстановление полного эрмитова спектра по половине
+    size_t half = nfft / 2;
+    for (size_t k = 0; k <= half; ++k)
+        work[k] = spectrum[k];
+    for (size_t k = half + 1; k < nfft; ++k)
+        work[k] = std::conj(spectrum[nfft - k]);
+
+    plan->inverse(work.data());
+
+    // перекрытие со сложением с окном синтеза; norm копит Σ w^2 для каждого отсчета
+    for (size_t i = 0; i < windowLength; ++i) {
+        accum[i] += work[i].real() * window[i];
+        norm[i] += window[i] * window[i];
+    }
+
+    // первые hop отсчетов больше не получат вкладов — переносим их в очередь
+    size_t cap = fifo.size();
+    for (size_t i = 0; i < hop; ++i) {
+        double y = norm[i] > 1e-12 ? accum[i] / norm[i] : 0.0;
+        if (fifoSize == cap) { // никто не читает выход — отбрасываем самый старый отсчет
+            fifoHead = (fifoHead + 1) % cap;
+            --fifoSize;
+        }
+        fifo[(fifoHead + fifoSize) % cap] = y;
+        ++fifoSize;
+    }
+
+    std::copy(accum.begin() + hop, accum.end(), accum.begin());
+    std::fill(accum.end() - hop, accum.end(), 0.0);
+    std::copy(norm.begin() + hop, norm.end(), norm.begin());
+    std::fill(norm.end() - hop, norm.end(), 0.0);
+}
+
+double ISTFT::process(const std::vector<double>& inputs) {
+    (void)inputs; // отсчеты приходят через pushFrame
+    if (fifoSize == 0) return 0.0;
+    double y = fifo[fifoHead];
+    fifoHead = (fifoHead + 1) % fifo.size();
+    --fifoSize;
+    return y;
+}
+
+void ISTFT::reset() {
+    std::fill(accum.begin(), accum.end(), 0.0);
+    std::fill(norm.begin(), norm.end(), 0.0);
+    fifoHead = 0;
+    fifoSize = 0;
+}
+
+std::unique_ptr<Block> ISTFT::clone() const {
+    return std::make_unique<ISTFT>(*this);
+}
@@ -0,0 +1,215 @@
+#pragma once
+#include <complex>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Block.h"
+#include "FFT.h"
+#include "Window.h"
+
+class ISTFT;
+
+/**
+ * @brief Масштаб значений спектрограммы, выдаваемых блоком STFT.
+ */
+enum class SpectrumScale {
+    Magnitude = 0, /**< Модуль |X[k]| */
+    Power = 1,     /**< Мощность |X[k]|^2 */
+    Decibel = 2    /**< 20 * log10(|X[k]|), ограничено снизу -300 дБ */
+};
+
+/**
+ * @brief Блок кратковременного преобразования Фурье (STFT) с потоковым выводом кадров.
+ * @details Пропускает входной сигнал без изменений (выход блока равен входу), а каждые
+ * hop отсчетов вычисляет спектр последних windowLength отсчетов, умноженных на окно
+ * и дополненных нулями до nfft. Кадр из nfft/2 + 1 значений выдается в callback и/или
+ * в буфер вызывающей стороны. План БПФ и окно вычисляются один раз при создании блока.
+ *
+ * Буфер спектрограммы хранится по строкам частот: значение бина k кадра f находится
+ * по адресу buffer[k * maxFrames + f % maxFrames]. Такой массив размера (nBins x maxFrames)
+ * напрямую строится как изображение (строки — частоты, столбцы — время); при переполнении
+ * запись продолжается по кругу, что дает «бегущую» спектрограмму.
+ */
+class STFT : public Block {
+public:
+    /** @brief Обработчик готового кадра: значения бинов, их количество, номер кадра. */
+    typedef std::function<void(const double* frame, size_t nBins, size_t frameIndex)> FrameCallback;
+
+    /** @brief Обработчик комплексного спектра перед синтезом (может изменять спектр). */
+    typedef std::function<void(std::complex<double>* spectrum, size_t nBins, size_t frameIndex)> SpectrumCallback;
+
+private:
+    size_t windowLength;   /**< Длина окна анализа */
+    size_t hop;            /**< Шаг между кадрами */
+    size_t nfft;           /**< Длина БПФ */
+    SpectrumScale scale;   /**< Масштаб выдаваемых значений */
+    std::vector<double> window;              /**< Окно анализа */
+    std::shared_ptr<const FFTPlan> plan;     /**< План БПФ из общего кэша */
+
+    std::vector<double> ring;                /**< Кольцевой буфер последних windowLength отсчетов */
+    size_t pos;            /**< Позиция записи в кольцевом буфере */
+    size_t untilFrame;     /**< Отсчетов до следующего кадра */
+    size_t frameCount;     /**< Количество кадров с момента сброса */
+
+    std::vector<std::complex<double>> work;  /**< Рабочий массив БПФ */
+    std::vector<double> values;              /**< Значения текущего кадра в выбранном масштабе */
+
+    double* outBuffer;     /**< Буфер спектрограммы вызывающей стороны (может быть nullptr) */
+    size_t maxFrames;      /**< Емкость буфера в кадрах */
+    FrameCallback frameCallback;
+    SpectrumCallback spectrumCallback;
+    ISTFT* inverse;        /**< Связанный блок синтеза (может быть nullptr) */
+
+    void emitFrame();
+
+public:
+    /**
+     * @brief Конструктор блока STFT.
+     * @param nm Имя блока.
+     * @param windowType Тип окна анализа.
+     * @param windowLength Длина окна (больше нуля, не больше nfft).
+     * @param hop Шаг между кадрами (от 1 до windowLength).
+     * @param nfft Длина БПФ (любая, степень двойки быстрее).
+     * @param scale Масштаб выдаваемых значений.
+     * @throw std::invalid_argument При некорректных параметрах.
+     */
+    STFT(const std::string& nm, WindowType windowType, size_t windowLength, size_t hop, size_t nfft,
+        SpectrumScale scale = SpectrumScale::Magnitude);
+
+    /**
+     * @brief Принимает очередной отсчет и при необходимости выдает кадр.
+     * @param inputs Вектор входных данных. Ожидается размер, равный 1.
+     * @return Входной отсчет без изменений.
+     */
+    double process(const std::vector<double>& inputs) override;
+
+    /**
+     * @brief Сброс буфера отсчетов и счетчика кадров.
+     */
+    void reset() override;
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @details Буфер спектрограммы и обработчик кадров не копируются: копия не пишет
+     * в приемники исходного блока. Обработчик спектра копируется как часть обработки.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+
+    /**
+     * @brief Перенаправляет связь с блоком синтеза на его копию.
+     * @param map Соответствие «исходный блок -> копия».
+     */
+    void remapLinks(const std::unordered_map<const Block*, Block*>& map) override;
+
+    /**
+     * @brief Передаточная функция: блок пропускает вход без изменений.
+     * @param inputs Передаточные функции входов. Ожидается размер, равный 1.
+     * @param out Передаточная функция выхода (совпадает с входной).
+     * @return Всегда true.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override;
+
+    /**
+     * @brief Задать буфер спектрограммы (nBins * maxFrames значений).
+     * @param buffer Указатель на буфер или nullptr, чтобы отключить запись.
+     * @param frames Емкость буфера в кадрах.
+     */
+    void setOutputBuffer(double* buffer, size_t frames);
+
+    /**
+     * @brief Задать обработчик готовых кадров.
+     * @param cb Функция, вызываемая для каждого кадра (пустая — отключить).
+     */
+    void setFrameCallback(FrameCallback cb);
+
+    /**
+     * @brief Задать обработчик комплексного спектра (вызывается перед передачей кадра в ISTFT).
+     * @param cb Функция, которая может изменять спектр на месте (пустая — отключить).
+     */
+    void setSpectrumCallback(SpectrumCallback cb);
+
+    /**
+     * @brief Связать блок синтеза: каждый комплексный кадр будет передан в inv.
+     * @param inv Блок ISTFT с теми же параметрами или nullptr.
+     */
+    void attachInverse(ISTFT* inv);
+
+    /** @brief Количество частотных бинов в кадре: nfft / 2 + 1. */
+    size_t getBinCount() const { return nfft / 2 + 1; }
+
+    /** @brief Количество кадров, выданных с момента последнего сброса. */
+    size_t getFrameCount() const { return frameCount; }
+
+    /** @brief Длина окна анализа. */
+    size_t getWindowLength() const { return windowLength; }
+
+    /** @brief Шаг между кадрами. */
+    size_t getHop() const { return hop; }
+
+    /** @brief Длина БПФ. */
+    size_t getFFTSize() const { return nfft; }
+
+    /** @brief Окно анализа. */
+    const std::vector<double>& getWindow() const { return window; }
+};
+
+/**
+ * @brief Блок обратного STFT: синтез сигнала методом взвешенного перекрытия со сложением.
+ * @details Принимает комплексные кадры от связанного блока STFT (pushFrame), выполняет
+ * обратное БПФ, умножает на окно синтеза и складывает с перекрытием. Нормировка на сумму
+ * квадратов окон ведется для каждого отсчета, поэтому без изменения спектра выход точно
+ * повторяет вход с задержкой windowLength - 1 отсчетов везде, где накопленная сумма
+ * квадратов окон не равна нулю. Отсчеты, попавшие только в нулевые позиции окна
+ * (например, x[0] при периодическом окне Ханна, у которого window[0] == 0), теряются
+ * и выдаются как 0.0.
+ * Метод process() ничего не вычисляет по своему входу: он выдает по одному готовому
+ * отсчету синтеза за вызов (0.0, пока отсчеты не готовы).
+ */
+class ISTFT : public Block {
+private:
+    size_t windowLength;   /**< Длина окна */
+    size_t hop;            /**< Шаг между кадрами */
+    size_t nfft;           /**< Длина БПФ */
+    std::vector<double> window;              /**< Окно синтеза */
+    std::shared_ptr<const FFTPlan> plan;     /**< План БПФ из общего кэша */
+
+    std::vector<double> accum;               /**< Накопитель перекрытия со сложением */
+    std::vector<double> norm;                /**< Накопленная сумма квадратов окна для каждого отсчета */
+    std::vector<double> fifo;                /**< Готовые отсчеты синтеза (кольцевой буфер) */
+    size_t fifoHead;       /**< Индекс чтения */
+    size_t fifoSize;       /**< Количество готовых отсчетов */
+    std::vector<std::complex<double>> work;  /**< Рабочий массив БПФ */
+
+public:
+    /**
+     * @brief Конструктор блока синтеза с параметрами, совпадающими с блоком анализа.
+     * @param nm Имя блока.
+     * @param analysis Блок STFT, параметры и окно которого используются для синтеза.
+     */
+    ISTFT(const std::string& nm, const STFT& analysis);
+
+    /**
+     * @brief Добавить кадр спектра (nfft / 2 + 1 комплексных значений).
+     * @param spectrum Половина эрмитова спектра кадра.
+     */
+    void pushFrame(const std::complex<double>* spectrum);
+
+    /**
+     * @brief Выдает очередной готовый отсчет синтеза.
+     * @param inputs Вход блока (игнорируется; нужен для порядка вычислений в графе).
+     * @return Отсчет восстановленного сигнала или 0.0, если отсчет еще не готов.
+     */
+    double process(const std::vector<double>& inputs) override;
+
+    /**
+     * @brief Сброс накопителей и очереди готовых отсчетов.
+     */
+    void reset() override;
+
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+};
@@ -18,3 +18,18 @@ void Summator::reset() {
     // Сумматор не хранит состояние — ничего не делаем
 }
 
+
+bool Summator::getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const {
+    assert(inputs.size() == 2);
+    out = TransferFunction::weightedSum(u, inputs[0], v, inputs[1]); // H = u * H1 + v * H2
+    return true;
+}
+
+bool Summator::getHistoryLength(size_t& length) const {
+    length = 0; // блок без памяти
+    return true;
+}
+
+std::unique_ptr<Block> Summator::clone() const {
+    return std::make_unique<Summator>(*this);
+}
@@ -33,6 +33,27 @@ public:
      */
     void reset() override;
 
+    /**
+     * @brief Создает независимую копию блока вместе с текущим состоянием.
+     * @return Новый блок того же типа.
+     */
+    std::unique_ptr<Block> clone() const override;
+
+    /**
+     * @brief Память сумматора: выход зависит только от текущих входов.
+     * @param length Всегда 0.
+     * @return Всегда true.
+     */
+    bool getHistoryLength(size_t& length) const override;
+
+    /**
+     * @brief Передаточная функция сумматора: u * H1(z) + v * H2(z).
+     * @param inputs Передаточные функции двух входов.
+     * @param out Передаточная функция выхода.
+     * @return Всегда true: блок линейный.
+     */
+    bool getTransferFunction(const std::vector<TransferFunction>& inputs, TransferFunction& out) const override;
+
     /**
      * @brief Перегрузка оператора вызова функции "()".
      * @param x1 Значение первого сигнала.
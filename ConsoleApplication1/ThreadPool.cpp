@@ -0,0 +1,185 @@
+#include "ThreadPool.h"
+#include "Denormals.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+struct ThreadPool::Job {
+    const Task* fn;
+    size_t count;
+    size_t maxWorkers;
+    std::atomic<size_t> next;
+    size_t done;                /**< Сколько потоков завершили задачу (под mutex) */
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+// признак того, что текущий поток — рабочий поток какого-либо пула
+static thread_local bool t_inPool = false;
+
+// разбор списка процессоров вида "0-15,32-47"
+static std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> result;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty() || item == "\n") continue;
+        size_t dash = item.find('-');
+        try {
+            int lo = std::stoi(item.substr(0, dash));
+            int hi = (dash == std::string::npos) ? lo : std::stoi(item.substr(dash + 1));
+            for (int c = lo; c <= hi; ++c) result.push_back(c);
+        }
+        catch (const std::exception&) {
+            // нераспознанный фрагмент пропускается
+        }
+    }
+    return result;
+}
+
+std::vector<std::vector<int>> ThreadPool::numaNodes() {
+    std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool haveMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    for (int node = 0; node < 1024; ++node) {
+        std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!f) continue; // номера узлов могут идти с пропусками
+        std::string line;
+        std::getline(f, line);
+        std::vector<int> cpus;
+        for (int c : parseCpuList(line))
+            if (!haveMask || (c < CPU_SETSIZE && CPU_ISSET(c, &allowed))) cpus.push_back(c);
+        if (!cpus.empty()) nodes.push_back(cpus);
+    }
+
+    if (nodes.empty() && haveMask) {
+        std::vector<int> cpus;
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+            if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+        if (!cpus.empty()) nodes.push_back(cpus);
+    }
+#endif
+    if (nodes.empty()) {
+        std::vector<int> cpus;
+        unsigned n = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned c = 0; c < n; ++c) cpus.push_back(static_cast<int>(c));
+        nodes.push_back(cpus);
+    }
+    return nodes;
+}
+
+ThreadPool::ThreadPool(size_t threads, bool pinThreads)
+    : current(nullptr), generation(0), stop(false) {
+    std::vector<std::vector<int>> nodes = numaNodes();
+
+    // порядок процессоров: по одному с каждого узла по кругу
+    std::vector<int> order;
+    size_t total = 0;
+    for (const auto& n : nodes) total += n.size();
+    for (size_t k = 0; order.size() < total; ++k)
+        for (const auto& n : nodes)
+            if (k < n.size()) order.push_back(n[k]);
+
+    if (threads == 0) threads = std::max<size_t>(1, order.size());
+    cpus.resize(threads, -1);
+    if (pinThreads && !order.empty())
+        for (size_t i = 0; i < threads; ++i) cpus[i] = order[i % order.size()];
+
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    t_inPool = true;
+    ScopedFlushDenormals flushDenormals; // на все время жизни рабочего потока
+#ifdef __linux__
+    if (cpus[index] >= 0 && cpus[index] < CPU_SETSIZE) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[index], &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set); // при ошибке поток просто не закреплен
+    }
+#endif
+
+    size_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stop || generation != seen; });
+        if (stop) return;
+        seen = generation;
+        Job* job = current;
+        lock.unlock();
+
+        if (index < job->maxWorkers) {
+            for (;;) {
+                size_t i = job->next.fetch_add(1);
+                if (i >= job->count) break;
+                try {
+                    (*job->fn)(i, index);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> g(job->errorMutex);
+                    if (!job->error) job->error = std::current_exception();
+                    job->next.store(job->count); // остальные элементы не обрабатываются
+                }
+            }
+        }
+
+        lock.lock();
+        if (++job->done == workers.size()) finished.notify_all();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const Task& fn, size_t maxWorkers) {
+    if (count == 0) return;
+
+    // вложенный вызов из рабочего потока выполняется на месте, иначе пул заблокируется
+    if (t_inPool || workers.empty()) {
+        for (size_t i = 0; i < count; ++i) fn(i, 0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> run(runMutex);
+    Job job;
+    job.fn = &fn;
+    job.count = count;
+    job.maxWorkers = (maxWorkers == 0) ? workers.size() : std::min(maxWorkers, workers.size());
+    job.next.store(0);
+    job.done = 0;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    current = &job;
+    ++generation;
+    wake.notify_all();
+    finished.wait(lock, [&] { return job.done == workers.size(); });
+    current = nullptr;
+    lock.unlock();
+
+    if (job.error) std::rethrow_exception(job.error);
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
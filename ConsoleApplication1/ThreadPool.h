@@ -0,0 +1,85 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Пул рабочих потоков для параллельной обработки.
+ * @details Потоки создаются один раз и ждут задач. На Linux каждый поток закрепляется
+ * за логическим процессором с учетом NUMA-топологии (/sys/devices/system/node):
+ * потоки по очереди распределяются по узлам, поэтому нагрузка на память делится
+ * между узлами, а данные, созданные потоком (первое касание), остаются локальными.
+ * Учитывается маска доступных процессору ядер (taskset, cgroups).
+ * В рабочих потоках включен сброс денормализованных чисел (ScopedFlushDenormals).
+ */
+class ThreadPool {
+public:
+    /** @brief Задача parallelFor: номер элемента и номер рабочего потока. */
+    typedef std::function<void(size_t index, size_t worker)> Task;
+
+private:
+    struct Job;
+
+    std::vector<std::thread> workers;   /**< Рабочие потоки */
+    std::vector<int> cpus;              /**< Процессор для каждого потока (-1 — без закрепления) */
+    std::mutex mutex;                   /**< Защищает current, generation, stop */
+    std::condition_variable wake;       /**< Сигнал о новой задаче */
+    std::condition_variable finished;   /**< Сигнал о завершении задачи всеми потоками */
+    std::mutex runMutex;                /**< Одна задача parallelFor в момент времени */
+    Job* current;                       /**< Текущая задача */
+    size_t generation;                  /**< Номер текущей задачи */
+    bool stop;                          /**< Признак остановки пула */
+
+    void workerLoop(size_t index);
+
+public:
+    /**
+     * @brief Конструктор пула.
+     * @param threads Количество потоков (0 — по числу доступных процессоров).
+     * @param pinThreads Закреплять потоки за процессорами с учетом NUMA.
+     */
+    explicit ThreadPool(size_t threads = 0, bool pinThreads = true);
+
+    /**
+     * @brief Деструктор: дожидается завершения потоков.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Количество рабочих потоков.
+     * @return Размер пула.
+     */
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Выполняет fn(i, worker) для i = 0 ... count-1 и ждет завершения.
+     * @details Элементы раздаются потокам динамически (по одному), поэтому задачи разной
+     * длительности балансируются автоматически. Номер worker меньше maxWorkers и
+     * позволяет хранить данные отдельно для каждого потока. Вызов из рабочего потока
+     * этого же пула выполняется последовательно в вызывающем потоке (worker = 0).
+     * @param count Количество элементов.
+     * @param fn Функция обработки элемента.
+     * @param maxWorkers Наибольшее число участвующих потоков (0 — все).
+     * @throw Первое исключение, выброшенное fn (остальные элементы при этом пропускаются).
+     */
+    void parallelFor(size_t count, const Task& fn, size_t maxWorkers = 0);
+
+    /**
+     * @brief Общий пул библиотеки (создается при первом обращении).
+     * @return Пул с потоками по числу доступных процессоров.
+     */
+    static ThreadPool& shared();
+
+    /**
+     * @brief Логические процессоры, доступные процессу, сгруппированные по NUMA-узлам.
+     * @return Список узлов; каждый узел — список номеров процессоров.
+     * Если топология недоступна, возвращается один узел со всеми процессорами.
+     */
+    static std::vector<std::vector<int>> numaNodes();
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <vector>
+
+/**
+ * @brief Рациональная передаточная функция H(z) = B(z) / A(z).
+ * @details Полиномы хранятся по возрастанию степеней z^-1:
+ * B(z) = b[0] + b[1]*z^-1 + ..., A(z) = a[0] + a[1]*z^-1 + ...
+ * Используется модулем FilterAnalysis и методом ProcessingSystem::getTransferFunction
+ * для анализа отдельных блоков и целых графов обработки.
+ */
+struct TransferFunction {
+    std::vector<double> b; /**< Коэффициенты числителя */
+    std::vector<double> a; /**< Коэффициенты знаменателя (обычно a[0] = 1) */
+
+    /**
+     * @brief Тождественная передаточная функция H(z) = 1.
+     * @return Передаточная функция внешнего входа системы.
+     */
+    static TransferFunction identity() {
+        return TransferFunction{ { 1.0 }, { 1.0 } };
+    }
+
+    /**
+     * @brief Произведение двух полиномов по степеням z^-1 (свертка коэффициентов).
+     * @param p Первый полином.
+     * @param q Второй полином.
+     * @return Коэффициенты полинома p * q.
+     */
+    static std::vector<double> polyMul(const std::vector<double>& p, const std::vector<double>& q) {
+        if (p.empty() || q.empty()) return {};
+        std::vector<double> r(p.size() + q.size() - 1, 0.0);
+        for (size_t i = 0; i < p.size(); ++i)
+            for (size_t j = 0; j < q.size(); ++j)
+                r[i + j] += p[i] * q[j];
+        return r;
+    }
+
+    /**
+     * @brief Взвешенная сумма полиномов u*p + v*q.
+     * @param u Вес первого полинома.
+     * @param p Первый полином.
+     * @param v Вес второго полинома.
+     * @param q Второй полином.
+     * @return Коэффициенты результирующего полинома.
+     */
+    static std::vector<double> polyAdd(double u, const std::vector<double>& p, double v, const std::vector<double>& q) {
+        std::vector<double> r(p.size() > q.size() ? p.size() : q.size(), 0.0);
+        for (size_t i = 0; i < p.size(); ++i) r[i] += u * p[i];
+        for (size_t i = 0; i < q.size(); ++i) r[i] += v * q[i];
+        return r;
+    }
+
+    /**
+     * @brief Последовательное соединение (каскад) двух звеньев: H = H1 * H2.
+     * @param other Второе звено каскада.
+     * @return Передаточная функция каскада.
+     */
+    TransferFunction cascade(const TransferFunction& other) const {
+        return TransferFunction{ polyMul(b, other.b), polyMul(a, other.a) };
+    }
+
+    /**
+     * @brief Параллельное соединение с весами: H = u*H1 + v*H2.
+     * @details При совпадающих знаменателях (например, оба входа взяты с одного блока)
+     * знаменатель не возводится в квадрат.
+     * @param u Вес первого звена.
+     * @param h1 Первое звено.
+     * @param v Вес второго звена.
+     * @param h2 Второе звено.
+     * @return Передаточная функция взвешенной суммы.
+     */
+    static TransferFunction weightedSum(double u, const TransferFunction& h1, double v, const TransferFunction& h2) {
+        if (h1.a == h2.a)
+            return TransferFunction{ polyAdd(u, h1.b, v, h2.b), h1.a };
+        return TransferFunction{
+            polyAdd(u, polyMul(h1.b, h2.a), v, polyMul(h2.b, h1.a)),
+            polyMul(h1.a, h2.a)
+        };
+    }
+};
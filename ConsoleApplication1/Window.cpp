@@ -0,0 +1,56 @@
+#include "Window.h"
+#include <cmath>
+#include <stdexcept>
+
+static const double PI = 3.14159265358979323846;
+
+double Window::besselI0(double x) {
+    // степенной ряд: I0(x) = Σ ((x/2)^k / k!)^2
+    double sum = 1.0;
+    double term = 1.0;
+    double half = x / 2.0;
+    for (int k = 1; k < 500; ++k) {
+        term *= half / k;
+        double t2 = term * term;
+        sum += t2;
+        if (t2 < sum * 1e-17) break;
+    }
+    return sum;
+}
+
+std::vector<double> Window::generate(WindowType type, size_t n, double beta, bool periodic) {
+    std::vector<double> w(n, 1.0);
+    if (n <= 1) return w;
+
+    // для периодического окна знаменатель равен n (последний отсчет — начало следующего периода)
+    double m = periodic ? static_cast<double>(n) : static_cast<double>(n - 1);
+
+    switch (type) {
+    case WindowType::Rectangular:
+        break;
+    case WindowType::Hann:
+        for (size_t i = 0; i < n; ++i)
+            w[i] = 0.5 - 0.5 * std::cos(2.0 * PI * i / m);
+        break;
+    case WindowType::Hamming:
+        for (size_t i = 0; i < n; ++i)
+            w[i] = 0.54 - 0.46 * std::cos(2.0 * PI * i / m);
+        break;
+    case WindowType::Blackman:
+        for (size_t i = 0; i < n; ++i)
+            w[i] = 0.42 - 0.5 * std::cos(2.0 * PI * i / m) + 0.08 * std::cos(4.0 * PI * i / m);
+        break;
+    case WindowType::Kaiser: {
+        double denom = besselI0(beta);
+        for (size_t i = 0; i < n; ++i) {
+            double r = 2.0 * i / m - 1.0;
+            double arg = 1.0 - r * r;
+            w[i] = besselI0(beta * std::sqrt(arg > 0.0 ? arg : 0.0)) / denom;
+        }
+        break;
+    }
+    default:
+        throw std::invalid_argument("Unknown window type");
+    }
+    return w;
+}
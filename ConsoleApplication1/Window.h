@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Типы оконных функций.
+ */
+enum class WindowType {
+    Rectangular = 0, /**< Прямоугольное окно */
+    Hann = 1,        /**< Окно Ханна */
+    Hamming = 2,     /**< Окно Хэмминга */
+    Blackman = 3,    /**< Окно Блэкмана */
+    Kaiser = 4       /**< Окно Кайзера (параметр beta) */
+};
+
+/**
+ * @brief Генератор оконных функций.
+ * @details Используется при проектировании КИХ-фильтров методом окон (FilterDesign)
+ * и при кратковременном преобразовании Фурье (STFT).
+ */
+class Window {
+public:
+    /**
+     * @brief Построить окно заданной длины.
+     * @param type Тип окна.
+     * @param n Длина окна (количество отсчетов).
+     * @param beta Параметр формы окна Кайзера (для остальных окон игнорируется).
+     * @param periodic true — периодическое окно (для спектрального анализа, период n),
+     * false — симметричное окно (для проектирования фильтров).
+     * @return Вектор из n отсчетов окна.
+     * @throw std::invalid_argument Если тип окна неизвестен.
+     */
+    static std::vector<double> generate(WindowType type, size_t n, double beta = 8.6, bool periodic = false);
+
+    /**
+     * @brief Модифицированная функция Бесселя первого рода нулевого порядка I0(x).
+     * @param x Аргумент.
+     * @return Значение I0(x).
+     */
+    static double besselI0(double x);
+};
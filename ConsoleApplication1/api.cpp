@@ -3,14 +3,28 @@
 #include "FIRFilter.h"
 #include "IIRFilter.h"
 #include "Summator.h"
+#include "FixedFilters.h"
+#include "MovingStatistics.h"
+#include "Generators.h"
+#include "FixedPoint.h"
+#include "FilterAnalysis.h"
+#include "FilterDesign.h"
+#include "STFT.h"
+#include "BatchProcessor.h"
+#include "AsyncExecutor.h"
 #include <iostream>
 #include <string>
 #include <vector>
 #include <memory>
 #include <stdexcept>
+#include <algorithm>
+#include <complex>
+#include <atomic>
+#include <deque>
+#include <mutex>
 
-// Глобальная переменная для хранения ошибки
-static std::string g_lastError = "";
+// Текст последней ошибки: свой в каждом потоке (асинхронные задания выполняются в других потоках)
+static thread_local std::string g_lastError = "";
 
 const char* getLastError() {
     if (g_lastError.empty()) {
@@ -37,6 +51,7 @@ void* createSystem() {
 void destroySystem(void* systemPtr) {
     // destroySystem обычно не кидает исключений, но для безопасности можно обернуть
     if (systemPtr) {
+        AsyncExecutor::shared().wait(systemPtr); // асинхронные задания используют систему
         delete static_cast<ProcessingSystem*>(systemPtr);
     }
 }
@@ -47,7 +62,7 @@ void addFIR(void* systemPtr, const char* name, const double* coeffs, int n) {
         if (!systemPtr) throw std::runtime_error("System pointer is null");
         auto* sys = static_cast<ProcessingSystem*>(systemPtr);
         std::vector<double> b(coeffs, coeffs + n);
-        sys->addBlock(std::make_unique<FIRFilter>(name, b));
+        sys->addBlock(FilterFactory::makeFIR(name, b)); // короткие фильтры — FixedFIR
     }
     catch (const std::exception& e) {
         g_lastError = std::string("addFIR error: ") + e.what();
@@ -63,7 +78,7 @@ void addIIR(void* systemPtr, const char* name,
         auto* sys = static_cast<ProcessingSystem*>(systemPtr);
         std::vector<double> vb(b, b + nB);
         std::vector<double> va(a, a + nA);
-        sys->addBlock(std::make_unique<IIRFilter>(name, vb, va));
+        sys->addBlock(FilterFactory::makeIIR(name, vb, va)); // секции до биквада — FixedIIR
     }
     catch (const std::exception& e) {
         g_lastError = std::string("addIIR error: ") + e.what();
@@ -82,6 +97,217 @@ void addSummator(void* systemPtr, const char* name, double u, double v) {
     }
 }
 
+// Общая обертка для блоков скользящей статистики
+template <typename T>
+static void addMovingBlock(void* systemPtr, const char* name, int windowLength, const char* prefix) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        if (windowLength <= 0) throw std::invalid_argument("Window length must be positive");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        sys->addBlock(std::make_unique<T>(name, static_cast<size_t>(windowLength)));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string(prefix) + e.what();
+    }
+}
+
+void addMovingAverage(void* systemPtr, const char* name, int windowLength) {
+    addMovingBlock<MovingAverage>(systemPtr, name, windowLength, "addMovingAverage error: ");
+}
+
+void addMovingRMS(void* systemPtr, const char* name, int windowLength) {
+    addMovingBlock<MovingRMS>(systemPtr, name, windowLength, "addMovingRMS error: ");
+}
+
+void addMovingMin(void* systemPtr, const char* name, int windowLength) {
+    addMovingBlock<MovingMin>(systemPtr, name, windowLength, "addMovingMin error: ");
+}
+
+void addMovingMax(void* systemPtr, const char* name, int windowLength) {
+    addMovingBlock<MovingMax>(systemPtr, name, windowLength, "addMovingMax error: ");
+}
+
+void addMovingMedian(void* systemPtr, const char* name, int windowLength) {
+    addMovingBlock<MovingMedian>(systemPtr, name, windowLength, "addMovingMedian error: ");
+}
+
+void addSineGenerator(void* systemPtr, const char* name, double amplitude, double frequency, double phase) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        sys->addBlock(std::make_unique<SineGenerator>(name, amplitude, frequency, phase));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("addGenerator error: ") + e.what();
+    }
+}
+
+void addSquareGenerator(void* systemPtr, const char* name, double amplitude, double frequency, double duty) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        sys->addBlock(std::make_unique<SquareGenerator>(name, amplitude, frequency, duty));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("addGenerator error: ") + e.what();
+    }
+}
+
+void addChirpGenerator(void* systemPtr, const char* name, double amplitude, double f0, double f1, int sweepLength) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        if (sweepLength <= 0) throw std::invalid_argument("Sweep length must be positive");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        sys->addBlock(std::make_unique<ChirpGenerator>(name, amplitude, f0, f1, static_cast<size_t>(sweepLength)));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("addGenerator error: ") + e.what();
+    }
+}
+
+void addNoiseGenerator(void* systemPtr, const char* name, int color, double amplitude, unsigned long long seed) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        if (color != DSP_NOISE_WHITE && color != DSP_NOISE_PINK) throw std::invalid_argument("Unknown noise color");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        sys->addBlock(std::make_unique<NoiseGenerator>(name, amplitude,
+            color == DSP_NOISE_PINK ? NoiseColor::Pink : NoiseColor::White, static_cast<uint64_t>(seed)));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("addGenerator error: ") + e.what();
+    }
+}
+
+void generateSignal(void* systemPtr, const char* blockName, double* output, int length) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        if (length <= 0) return;
+        // нулевой внешний вход порциями: память не зависит от длины сигнала
+        const size_t chunk = 1 << 16;
+        size_t n = static_cast<size_t>(length);
+        std::vector<double> zeros(std::min(n, chunk), 0.0);
+        for (size_t pos = 0; pos < n; pos += chunk)
+            sys->processSignal(blockName, zeros.data(), output + pos, std::min(chunk, n - pos));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Generate error: ") + e.what();
+    }
+}
+
+static Rounding toRounding(int rounding) {
+    switch (rounding) {
+    case DSP_ROUND_TRUNCATE: return Rounding::Truncate;
+    case DSP_ROUND_NEAREST: return Rounding::Nearest;
+    case DSP_ROUND_CONVERGENT: return Rounding::Convergent;
+    default: throw std::invalid_argument("Unknown rounding mode");
+    }
+}
+
+// Блок с фиксированной точкой нужного формата: Block<int16_t> для Q15, Block<int32_t> для Q31
+template <template <class> class B, typename... Args>
+static std::unique_ptr<Block> makeFixedBlock(int format, Args&&... args) {
+    if (format == DSP_Q15) return std::make_unique<B<int16_t>>(std::forward<Args>(args)...);
+    if (format == DSP_Q31) return std::make_unique<B<int32_t>>(std::forward<Args>(args)...);
+    throw std::invalid_argument("Unknown fixed-point format");
+}
+
+void addFixedFIR(void* systemPtr, const char* name, const double* coeffs, int n, int format, int rounding) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        if (!coeffs || n <= 0) throw std::invalid_argument("Invalid coefficients");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        std::vector<double> b(coeffs, coeffs + n);
+        sys->addBlock(makeFixedBlock<FixedPointFIR>(format, name, b, toRounding(rounding)));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("addFixed error: ") + e.what();
+    }
+}
+
+void addFixedBiquad(void* systemPtr, const char* name, const double* b, int nB, const double* a, int nA,
+    int format, int rounding) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        if (!b || nB <= 0 || nA < 0 || (nA > 0 && !a)) throw std::invalid_argument("Invalid coefficients");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        std::vector<double> bv(b, b + nB), av(a, a + nA);
+        sys->addBlock(makeFixedBlock<FixedPointBiquad>(format, name, bv, av, toRounding(rounding)));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("addFixed error: ") + e.what();
+    }
+}
+
+void addFixedSummator(void* systemPtr, const char* name, double u, double v, int format, int rounding) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        sys->addBlock(makeFixedBlock<FixedPointSummator>(format, name, u, v, toRounding(rounding)));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("addFixed error: ") + e.what();
+    }
+}
+
+// Квантованный блок против блока в double: запас по разрядам, SNR и ошибка коэффициентов
+template <class T>
+static int reportFor(const std::vector<double>& b, const std::vector<double>& a, Rounding mode, double* snrDb, double* maxError) {
+    std::unique_ptr<Block> reference;
+    std::vector<double> exact, quantized;
+    int shift = 0;
+    if (a.empty()) {
+        FixedPointFIR<T> fixed("quantized", b, mode);
+        reference = std::make_unique<FIRFilter>("reference", b);
+        exact = b;
+        quantized = fixed.coefficients();
+        shift = fixed.headroom();
+        if (snrDb) *snrDb = FixedPoint::measureSNR(*reference, fixed);
+    }
+    else {
+        FixedPointBiquad<T> fixed("quantized", b, a, mode);
+        reference = std::make_unique<IIRFilter>("reference", b, a);
+        exact.assign(5, 0.0);
+        std::copy(b.begin(), b.end(), exact.begin());
+        std::copy(a.begin(), a.end(), exact.begin() + 3);
+        quantized = fixed.coefficients();
+        shift = fixed.headroom();
+        if (snrDb) *snrDb = FixedPoint::measureSNR(*reference, fixed);
+    }
+    if (maxError) {
+        *maxError = 0.0;
+        for (size_t i = 0; i < exact.size(); ++i)
+            *maxError = std::max(*maxError, std::fabs(exact[i] - quantized[i]));
+    }
+    return shift;
+}
+
+int quantizationReport(const double* b, int nB, const double* a, int nA, int format, int rounding,
+    double* snrDb, double* maxError) {
+    clearError();
+    try {
+        if (!b || nB <= 0 || nA < 0 || (nA > 0 && !a)) throw std::invalid_argument("Invalid coefficients");
+        std::vector<double> bv(b, b + nB), av(a, a + nA);
+        Rounding mode = toRounding(rounding);
+        if (format == DSP_Q15) return reportFor<int16_t>(bv, av, mode, snrDb, maxError);
+        if (format == DSP_Q31) return reportFor<int32_t>(bv, av, mode, snrDb, maxError);
+        throw std::invalid_argument("Unknown fixed-point format");
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("quantizationReport error: ") + e.what();
+        return -1;
+    }
+}
+
 void connect(void* systemPtr, const char* outputBlock, const char** sourceBlocks, int nSources) {
     clearError();
     try {
@@ -102,6 +328,7 @@ double computeBlock(void* systemPtr, const char* blockName, double input) {
     try {
         if (!systemPtr) throw std::runtime_error("System pointer is null");
         auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        ScopedFlushDenormals flushDenormals;
         return sys->computeBlock(blockName, input);
     }
     catch (const std::exception& e) {
@@ -128,11 +355,544 @@ void processSignal(void* systemPtr, const char* blockName,
     try {
         if (!systemPtr) throw std::runtime_error("System pointer is null");
         auto* sys = static_cast<ProcessingSystem*>(systemPtr);
-        for (int i = 0; i < length; ++i) {
-            output[i] = sys->computeBlock(blockName, input[i]);
-        }
+        if (length <= 0) return;
+        sys->processSignal(blockName, input, output, static_cast<size_t>(length));
     }
     catch (const std::exception& e) {
         g_lastError = std::string("Processing error: ") + e.what();
     }
 }
+
+int addTap(void* systemPtr, const char* blockName) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        return static_cast<int>(static_cast<ProcessingSystem*>(systemPtr)->addTap(blockName));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Tap error: ") + e.what();
+        return -1;
+    }
+}
+
+void clearTaps(void* systemPtr) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        static_cast<ProcessingSystem*>(systemPtr)->clearTaps();
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Tap error: ") + e.what();
+    }
+}
+
+void processWithTaps(void* systemPtr, const double* input, double* const* outputs, int length) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        if (length <= 0) return;
+        if (!outputs && sys->getTapCount() > 0) throw std::invalid_argument("Output buffers are null");
+        sys->processWithTaps(input, outputs, static_cast<size_t>(length));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Processing error: ") + e.what();
+    }
+}
+
+void setProcessingThreads(void* systemPtr, int threads) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        if (threads < 0) throw std::invalid_argument("Number of threads must not be negative");
+        static_cast<ProcessingSystem*>(systemPtr)->setProcessingThreads(static_cast<size_t>(threads));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Processing error: ") + e.what();
+    }
+}
+
+int processBatch(void* systemPtr, const char* blockName, const double* const* inputs, double* const* outputs,
+    const int* lengths, int nJobs, int nThreads, BatchProgressCallback progress, void* userData) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        if (nJobs < 0) throw std::invalid_argument("Number of jobs must not be negative");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        std::vector<const double*> in(inputs, inputs + nJobs);
+        std::vector<double*> out(outputs, outputs + nJobs);
+        std::vector<size_t> len(nJobs);
+        for (int i = 0; i < nJobs; ++i) {
+            if (lengths[i] < 0) throw std::invalid_argument("Signal length must not be negative");
+            len[i] = static_cast<size_t>(lengths[i]);
+        }
+
+        BatchProcessor::ProgressCallback cb;
+        if (progress) {
+            cb = [progress, userData](size_t done, size_t total) {
+                return progress(static_cast<int>(done), static_cast<int>(total), userData) == 0;
+            };
+        }
+        bool complete = BatchProcessor::run(*sys, blockName, in, out, len,
+            nThreads > 0 ? static_cast<size_t>(nThreads) : 0, cb);
+        return complete ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Batch error: ") + e.what();
+        return -1;
+    }
+}
+
+// ===== Асинхронная обработка =====
+
+// завершение задания, поставленного без callback
+struct AsyncCompletion {
+    long long jobId;
+    int status;
+    std::string error;
+    void* userData;
+};
+
+static std::atomic<long long> g_nextJobId(1);
+static std::mutex g_completionMutex;
+static std::deque<AsyncCompletion> g_completions;
+
+long long submitProcess(void* systemPtr, const char* blockName, const double* input, double* output,
+    int length, ProcessCallback callback, void* userData) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        if (!blockName) throw std::invalid_argument("Block name is null");
+        if (length < 0) throw std::invalid_argument("Signal length must not be negative");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        long long id = g_nextJobId.fetch_add(1);
+
+        auto done = [id, callback, userData](std::exception_ptr error) {
+            std::string message;
+            if (error) {
+                try {
+                    std::rethrow_exception(error);
+                }
+                catch (const std::exception& e) {
+                    message = std::string("Processing error: ") + e.what();
+                }
+                catch (...) {
+                    message = "Processing error: unknown exception";
+                }
+            }
+            int status = error ? -1 : 0;
+            if (callback) {
+                g_lastError = message; // поток исполнителя: видно из callback через getLastError
+                callback(id, status, userData);
+                return;
+            }
+            std::lock_guard<std::mutex> lock(g_completionMutex);
+            g_completions.push_back({ id, status, message, userData });
+        };
+        try {
+            AsyncExecutor::shared().processAsync(*sys, blockName, input, output, static_cast<size_t>(length), done);
+        }
+        catch (const std::length_error& e) {
+            g_lastError = std::string("Async error: ") + e.what();
+            return 0; // очередь заполнена — не ошибка, задание можно повторить позже
+        }
+        return id;
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Async error: ") + e.what();
+        return -1;
+    }
+}
+
+int pollCompletion(long long* jobId, int* status, void** userData) {
+    clearError();
+    AsyncCompletion c;
+    {
+        std::lock_guard<std::mutex> lock(g_completionMutex);
+        if (g_completions.empty()) return 0;
+        c = std::move(g_completions.front());
+        g_completions.pop_front();
+    }
+    if (jobId) *jobId = c.jobId;
+    if (status) *status = c.status;
+    if (userData) *userData = c.userData;
+    g_lastError = c.error;
+    return 1;
+}
+
+void waitAsync(void* systemPtr) {
+    clearError();
+    AsyncExecutor::shared().wait(systemPtr);
+}
+
+void setAsyncQueueLimit(int maxJobs) {
+    clearError();
+    try {
+        if (maxJobs <= 0) throw std::invalid_argument("Queue limit must be positive");
+        AsyncExecutor::shared().setQueueLimit(static_cast<size_t>(maxJobs));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Async error: ") + e.what();
+    }
+}
+
+// ===== Анализ фильтров =====
+
+static TransferFunction systemTransferFunction(void* systemPtr, const char* blockName) {
+    if (!systemPtr) throw std::runtime_error("System pointer is null");
+    auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+    return sys->getTransferFunction(blockName);
+}
+
+// коэффициенты в соглашениях IIRFilter: A(z) = 1 - Σ a[j] * z^-(j+1)
+static TransferFunction coeffsTransferFunction(const double* b, int nB, const double* a, int nA) {
+    if (!b || nB <= 0) throw std::invalid_argument("Numerator coefficients must not be empty");
+    TransferFunction tf;
+    tf.b.assign(b, b + nB);
+    tf.a.assign(1, 1.0);
+    for (int j = 0; a && j < nA; ++j)
+        tf.a.push_back(-a[j]);
+    return tf;
+}
+
+static void checkPoints(int nPoints) {
+    if (nPoints <= 0) throw std::invalid_argument("Number of frequency points must be positive");
+}
+
+int getTransferFunction(void* systemPtr, const char* blockName,
+    double* b, int capB, double* a, int capA, int* nB, int* nA) {
+    clearError();
+    try {
+        TransferFunction tf = systemTransferFunction(systemPtr, blockName);
+        if (nB) *nB = static_cast<int>(tf.b.size());
+        if (nA) *nA = static_cast<int>(tf.a.size());
+        if (!b || !a || capB < static_cast<int>(tf.b.size()) || capA < static_cast<int>(tf.a.size()))
+            return 1;
+        std::copy(tf.b.begin(), tf.b.end(), b);
+        std::copy(tf.a.begin(), tf.a.end(), a);
+        return 0;
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Analysis error: ") + e.what();
+        return -1;
+    }
+}
+
+void frequencyResponse(void* systemPtr, const char* blockName, int nPoints, double* magnitude, double* phase) {
+    clearError();
+    try {
+        checkPoints(nPoints);
+        TransferFunction tf = systemTransferFunction(systemPtr, blockName);
+        FilterAnalysis::magnitudePhase(tf, nPoints, magnitude, phase);
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Analysis error: ") + e.what();
+    }
+}
+
+void groupDelay(void* systemPtr, const char* blockName, int nPoints, double* delay) {
+    clearError();
+    try {
+        checkPoints(nPoints);
+        TransferFunction tf = systemTransferFunction(systemPtr, blockName);
+        std::vector<double> gd = FilterAnalysis::groupDelay(tf, nPoints);
+        std::copy(gd.begin(), gd.end(), delay);
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Analysis error: ") + e.what();
+    }
+}
+
+void impulseResponse(void* systemPtr, const char* blockName, double* output, int length) {
+    clearError();
+    try {
+        TransferFunction tf = systemTransferFunction(systemPtr, blockName);
+        std::vector<double> h = FilterAnalysis::impulseResponse(tf, length > 0 ? length : 0);
+        std::copy(h.begin(), h.end(), output);
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Analysis error: ") + e.what();
+    }
+}
+
+void stepResponse(void* systemPtr, const char* blockName, double* output, int length) {
+    clearError();
+    try {
+        TransferFunction tf = systemTransferFunction(systemPtr, blockName);
+        std::vector<double> s = FilterAnalysis::stepResponse(tf, length > 0 ? length : 0);
+        std::copy(s.begin(), s.end(), output);
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Analysis error: ") + e.what();
+    }
+}
+
+int getPolesZeros(void* systemPtr, const char* blockName,
+    double* zerosRe, double* zerosIm, int capZeros,
+    double* polesRe, double* polesIm, int capPoles,
+    int* nZeros, int* nPoles) {
+    clearError();
+    try {
+        TransferFunction tf = systemTransferFunction(systemPtr, blockName);
+        auto z = FilterAnalysis::zeros(tf);
+        auto p = FilterAnalysis::poles(tf);
+        if (nZeros) *nZeros = static_cast<int>(z.size());
+        if (nPoles) *nPoles = static_cast<int>(p.size());
+        if (capZeros < static_cast<int>(z.size()) || capPoles < static_cast<int>(p.size()))
+            return 1;
+        for (size_t i = 0; i < z.size(); ++i) {
+            zerosRe[i] = z[i].real();
+            zerosIm[i] = z[i].imag();
+        }
+        for (size_t i = 0; i < p.size(); ++i) {
+            polesRe[i] = p[i].real();
+            polesIm[i] = p[i].imag();
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Analysis error: ") + e.what();
+        return -1;
+    }
+}
+
+int isStable(void* systemPtr, const char* blockName) {
+    clearError();
+    try {
+        TransferFunction tf = systemTransferFunction(systemPtr, blockName);
+        return FilterAnalysis::isStable(tf) ? 1 : 0;
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Analysis error: ") + e.what();
+        return -1;
+    }
+}
+
+void frequencyResponseCoeffs(const double* b, int nB, const double* a, int nA,
+    int nPoints, double* magnitude, double* phase) {
+    clearError();
+    try {
+        checkPoints(nPoints);
+        FilterAnalysis::magnitudePhase(coeffsTransferFunction(b, nB, a, nA), nPoints, magnitude, phase);
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Analysis error: ") + e.what();
+    }
+}
+
+void groupDelayCoeffs(const double* b, int nB, const double* a, int nA, int nPoints, double* delay) {
+    clearError();
+    try {
+        checkPoints(nPoints);
+        std::vector<double> gd = FilterAnalysis::groupDelay(coeffsTransferFunction(b, nB, a, nA), nPoints);
+        std::copy(gd.begin(), gd.end(), delay);
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Analysis error: ") + e.what();
+    }
+}
+
+// ===== Проектирование фильтров =====
+
+static BandType toBandType(int bandType) {
+    if (bandType < DSP_LOWPASS || bandType > DSP_BANDSTOP) throw std::invalid_argument("Unknown band type");
+    return static_cast<BandType>(bandType);
+}
+
+static IIRPrototype toPrototype(int prototype) {
+    if (prototype < DSP_BUTTERWORTH || prototype > DSP_ELLIPTIC) throw std::invalid_argument("Unknown IIR prototype");
+    return static_cast<IIRPrototype>(prototype);
+}
+
+// Прямая форма высокого порядка численно бесполезна: коэффициенты полиномов не задают
+// близко расположенные корни. Выше этого порядка доступен только каскад (designIIRSOS)
+static const size_t MAX_DIRECT_FORM_ORDER = 12;
+
+// Прямая форма сверяется с каскадом секций: при низких частотах среза точность
+// теряется и на меньших порядках
+static void checkDirectForm(const IIRDesign& d) {
+    if (d.tf.a.size() - 1 > MAX_DIRECT_FORM_ORDER)
+        throw std::invalid_argument("Direct-form IIR design is limited to order 12; use designIIRSOS");
+    const size_t nPoints = 64;
+    std::vector<std::complex<double>> direct = FilterAnalysis::frequencyResponse(d.tf, nPoints);
+    std::vector<std::complex<double>> cascade(nPoints, 1.0);
+    for (const auto& sec : d.sos) {
+        auto h = FilterAnalysis::frequencyResponse(TransferFunction{ { sec[0], sec[1], sec[2] }, { sec[3], sec[4], sec[5] } }, nPoints);
+        for (size_t k = 0; k < nPoints; ++k) cascade[k] *= h[k];
+    }
+    double peak = 0.0, error = 0.0;
+    for (size_t k = 0; k < nPoints; ++k) {
+        peak = std::max(peak, std::abs(cascade[k]));
+        error = std::max(error, std::abs(direct[k] - cascade[k]));
+    }
+    if (!(error <= 1e-4 * peak)) // расхождение выше -80 дБ от максимума
+        throw std::runtime_error("Direct-form coefficients lose precision for this specification; use designIIRSOS");
+}
+
+int designFIRWindow(int numTaps, int bandType, double f1, double f2, int windowType, double beta, double* taps) {
+    clearError();
+    try {
+        if (numTaps <= 0) throw std::invalid_argument("Number of taps must be positive");
+        if (windowType < DSP_WINDOW_RECT || windowType > DSP_WINDOW_KAISER) throw std::invalid_argument("Unknown window type");
+        std::vector<double> h = FilterDesign::firWindowed(numTaps, toBandType(bandType), f1, f2,
+            static_cast<WindowType>(windowType), beta);
+        std::copy(h.begin(), h.end(), taps);
+        return 0;
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Design error: ") + e.what();
+        return -1;
+    }
+}
+
+int designFIRRemez(int numTaps, const double* bands, const double* desired, const double* weights, int nBands, double* taps) {
+    clearError();
+    try {
+        if (numTaps <= 0 || nBands <= 0) throw std::invalid_argument("Number of taps and bands must be positive");
+        std::vector<double> vb(bands, bands + 2 * nBands);
+        std::vector<double> vd(desired, desired + nBands);
+        std::vector<double> vw;
+        if (weights) vw.assign(weights, weights + nBands);
+        std::vector<double> h = FilterDesign::firRemez(numTaps, vb, vd, vw);
+        std::copy(h.begin(), h.end(), taps);
+        return 0;
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Design error: ") + e.what();
+        return -1;
+    }
+}
+
+int designIIR(int order, int bandType, double f1, double f2, int prototype, double rp, double rs,
+    double* b, int capB, double* a, int capA, int* nB, int* nA) {
+    clearError();
+    try {
+        IIRDesign d = FilterDesign::iir(order, toBandType(bandType), f1, f2, toPrototype(prototype), rp, rs);
+        checkDirectForm(d);
+        std::vector<double> fb = FilterDesign::toFeedback(d.tf.a);
+        if (nB) *nB = static_cast<int>(d.tf.b.size());
+        if (nA) *nA = static_cast<int>(fb.size());
+        if (!b || !a || capB < static_cast<int>(d.tf.b.size()) || capA < static_cast<int>(fb.size()))
+            return 1;
+        std::copy(d.tf.b.begin(), d.tf.b.end(), b);
+        std::copy(fb.begin(), fb.end(), a);
+        return 0;
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Design error: ") + e.what();
+        return -1;
+    }
+}
+
+int designIIRSOS(int order, int bandType, double f1, double f2, int prototype, double rp, double rs,
+    double* sos, int capSections, int* nSections) {
+    clearError();
+    try {
+        IIRDesign d = FilterDesign::iir(order, toBandType(bandType), f1, f2, toPrototype(prototype), rp, rs);
+        if (nSections) *nSections = static_cast<int>(d.sos.size());
+        if (!sos || capSections < static_cast<int>(d.sos.size()))
+            return 1;
+        for (size_t i = 0; i < d.sos.size(); ++i) {
+            const auto& s = d.sos[i];
+            double* row = sos + 5 * i;
+            row[0] = s[0];
+            row[1] = s[1];
+            row[2] = s[2];
+            row[3] = -s[4] / s[3]; // обратная связь в соглашениях IIRFilter
+            row[4] = -s[5] / s[3];
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("Design error: ") + e.what();
+        return -1;
+    }
+}
+
+void clearDesignCache() {
+    FilterDesign::clearCache();
+}
+
+// ===== Спектральный анализ (STFT) =====
+
+static STFT* findSTFT(void* systemPtr, const char* name) {
+    if (!systemPtr) throw std::runtime_error("System pointer is null");
+    auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+    Block* block = sys->getBlock(name);
+    if (!block) throw std::logic_error(std::string("Block not found: ") + name);
+    auto* stft = dynamic_cast<STFT*>(block);
+    if (!stft) throw std::logic_error(std::string("Block is not an STFT: ") + name);
+    return stft;
+}
+
+void addSTFT(void* systemPtr, const char* name, int windowType, int windowLength, int hop, int nfft, int scale) {
+    clearError();
+    try {
+        if (!systemPtr) throw std::runtime_error("System pointer is null");
+        if (windowLength <= 0 || hop <= 0 || nfft <= 0) throw std::invalid_argument("STFT sizes must be positive");
+        if (windowType < DSP_WINDOW_RECT || windowType > DSP_WINDOW_KAISER) throw std::invalid_argument("Unknown window type");
+        if (scale < DSP_STFT_MAGNITUDE || scale > DSP_STFT_DB) throw std::invalid_argument("Unknown spectrum scale");
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        sys->addBlock(std::make_unique<STFT>(name, static_cast<WindowType>(windowType),
+            windowLength, hop, nfft, static_cast<SpectrumScale>(scale)));
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("addSTFT error: ") + e.what();
+    }
+}
+
+void setSTFTOutput(void* systemPtr, const char* name, double* buffer, int maxFrames) {
+    clearError();
+    try {
+        if (buffer && maxFrames <= 0) throw std::invalid_argument("Buffer capacity must be positive");
+        findSTFT(systemPtr, name)->setOutputBuffer(buffer, buffer ? maxFrames : 0);
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("STFT error: ") + e.what();
+    }
+}
+
+void setSTFTCallback(void* systemPtr, const char* name, STFTFrameCallback callback, void* userData) {
+    clearError();
+    try {
+        STFT* stft = findSTFT(systemPtr, name);
+        if (!callback) {
+            stft->setFrameCallback(nullptr);
+            return;
+        }
+        stft->setFrameCallback([callback, userData](const double* frame, size_t nBins, size_t index) {
+            callback(frame, static_cast<int>(nBins), static_cast<int>(index), userData);
+        });
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("STFT error: ") + e.what();
+    }
+}
+
+int getSTFTFrameCount(void* systemPtr, const char* name) {
+    clearError();
+    try {
+        return static_cast<int>(findSTFT(systemPtr, name)->getFrameCount());
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("STFT error: ") + e.what();
+        return -1;
+    }
+}
+
+void addISTFT(void* systemPtr, const char* name, const char* stftName) {
+    clearError();
+    try {
+        STFT* stft = findSTFT(systemPtr, stftName);
+        auto* sys = static_cast<ProcessingSystem*>(systemPtr);
+        auto inverse = std::make_unique<ISTFT>(name, *stft);
+        ISTFT* raw = inverse.get();
+        sys->addBlock(std::move(inverse));
+        // синтез вычисляется после анализа в том же такте
+        sys->connect(name, { stftName });
+        stft->attachInverse(raw);
+    }
+    catch (const std::exception& e) {
+        g_lastError = std::string("addISTFT error: ") + e.what();
+    }
+}
@@ -8,12 +8,16 @@
  */
 
  /*
-  * Макрос API_EXPORT скрывает специфичный для Windows синтаксис
+  * Макрос API_EXPORT скрывает специфичный для платформы синтаксис экспорта
   * и решает проблему парсинга функций генератором документации Doxygen.
+  * На Linux библиотека собирается с -fvisibility=hidden, поэтому наружу
+  * видны только функции, помеченные этим макросом.
   */
 #ifndef API_EXPORT
 #if defined(_WIN32) || defined(_WIN64)
 #define API_EXPORT __declspec(dllexport)
+#elif defined(__GNUC__) || defined(__clang__)
+#define API_EXPORT __attribute__((visibility("default")))
 #else
 #define API_EXPORT
 #endif
@@ -31,6 +35,7 @@ extern "C" {
 
     /**
      * @brief Уничтожает экземпляр системы и освобождает память.
+     * @details Предварительно дожидается завершения асинхронных заданий системы (submitProcess).
      * @param systemPtr Указатель на систему, полученный через createSystem().
      */
     API_EXPORT void destroySystem(void* systemPtr);
@@ -64,6 +69,172 @@ extern "C" {
      */
     API_EXPORT void addSummator(void* systemPtr, const char* name, double u, double v);
 
+    /**
+     * @brief Добавляет блок скользящего среднего (O(1) на отсчет при любой длине окна).
+     * @details Результат совпадает с addFIR с windowLength коэффициентами 1/windowLength.
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param windowLength Длина окна.
+     */
+    API_EXPORT void addMovingAverage(void* systemPtr, const char* name, int windowLength);
+
+    /**
+     * @brief Добавляет блок скользящего среднеквадратичного значения (O(1) на отсчет).
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param windowLength Длина окна.
+     */
+    API_EXPORT void addMovingRMS(void* systemPtr, const char* name, int windowLength);
+
+    /**
+     * @brief Добавляет блок скользящего минимума (амортизированное O(1) на отсчет).
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param windowLength Длина окна.
+     */
+    API_EXPORT void addMovingMin(void* systemPtr, const char* name, int windowLength);
+
+    /**
+     * @brief Добавляет блок скользящего максимума (амортизированное O(1) на отсчет).
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param windowLength Длина окна.
+     */
+    API_EXPORT void addMovingMax(void* systemPtr, const char* name, int windowLength);
+
+    /**
+     * @brief Добавляет блок скользящей медианы (O(log N) на отсчет).
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param windowLength Длина окна.
+     */
+    API_EXPORT void addMovingMedian(void* systemPtr, const char* name, int windowLength);
+
+    /** @brief Цвет шума для addNoiseGenerator. */
+    enum { DSP_NOISE_WHITE = 0, DSP_NOISE_PINK = 1 };
+
+    /**
+     * @brief Добавляет синусоидальный генератор: amplitude * sin(pi * frequency * n + phase).
+     * @details Генераторы — блоки без входов: внешний вход системы игнорируется. Выход генератора
+     * можно подать на вход фильтров через connect или записать в буфер (generateSignal).
+     * resetAll возвращает генератор к началу сигнала.
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param amplitude Амплитуда.
+     * @param frequency Частота, нормированная к частоте Найквиста (0 ... 1).
+     * @param phase Начальная фаза в радианах.
+     */
+    API_EXPORT void addSineGenerator(void* systemPtr, const char* name, double amplitude, double frequency, double phase);
+
+    /**
+     * @brief Добавляет генератор прямоугольного сигнала (+amplitude / -amplitude).
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param amplitude Амплитуда.
+     * @param frequency Частота, нормированная к частоте Найквиста (0 ... 1).
+     * @param duty Коэффициент заполнения (0 ... 1), 0.5 — меандр.
+     */
+    API_EXPORT void addSquareGenerator(void* systemPtr, const char* name, double amplitude, double frequency, double duty);
+
+    /**
+     * @brief Добавляет генератор ЛЧМ-сигнала: частота линейно меняется от f0 до f1
+     * за sweepLength отсчетов, затем развертка повторяется.
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param amplitude Амплитуда.
+     * @param f0 Начальная частота, нормированная к частоте Найквиста.
+     * @param f1 Конечная частота, нормированная к частоте Найквиста.
+     * @param sweepLength Длина развертки в отсчетах.
+     */
+    API_EXPORT void addChirpGenerator(void* systemPtr, const char* name, double amplitude, double f0, double f1, int sweepLength);
+
+    /**
+     * @brief Добавляет генератор гауссовского шума (белого или розового).
+     * @details Одинаковое зерно дает одинаковый сигнал на любой платформе и при любом
+     * разбиении сигнала на порции.
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param color Цвет шума (DSP_NOISE_WHITE, DSP_NOISE_PINK).
+     * @param amplitude Среднеквадратичное отклонение.
+     * @param seed Зерно генератора псевдослучайных чисел.
+     */
+    API_EXPORT void addNoiseGenerator(void* systemPtr, const char* name, int color, double amplitude, unsigned long long seed);
+
+    /**
+     * @brief Записывает в буфер следующие length отсчетов на выходе блока при нулевом внешнем входе.
+     * @details Предназначена для графов, источником которых служат генераторы: сигнал
+     * синтезируется внутри библиотеки без передачи входного массива.
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя блока (генератора или блока, подключенного к генераторам).
+     * @param output Буфер для отсчетов (length значений).
+     * @param length Количество отсчетов.
+     */
+    API_EXPORT void generateSignal(void* systemPtr, const char* blockName, double* output, int length);
+
+    /** @brief Формат с фиксированной точкой для addFixedFIR / addFixedBiquad / addFixedSummator. */
+    enum { DSP_Q15 = 15, DSP_Q31 = 31 };
+
+    /** @brief Режим округления: отбрасывание разрядов, к ближайшему, к ближайшему четному. */
+    enum { DSP_ROUND_TRUNCATE = 0, DSP_ROUND_NEAREST = 1, DSP_ROUND_CONVERGENT = 2 };
+
+    /**
+     * @brief Добавляет КИХ-фильтр с фиксированной точкой (Q15 или Q31).
+     * @details Коэффициенты квантуются с запасом по разрядам, при котором накопление
+     * не переполняется; вход и выход блока — double, но выход всегда насыщен к диапазону
+     * формата [-1, 1). Свертка считается целочисленными векторными инструкциями.
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param coeffs Коэффициенты фильтра (double).
+     * @param n Количество коэффициентов.
+     * @param format Формат (DSP_Q15, DSP_Q31).
+     * @param rounding Режим округления (DSP_ROUND_*).
+     */
+    API_EXPORT void addFixedFIR(void* systemPtr, const char* name, const double* coeffs, int n, int format, int rounding);
+
+    /**
+     * @brief Добавляет биквадратную секцию с фиксированной точкой.
+     * @details Те же соглашения о коэффициентах, что у addIIR: y = Σ b x + Σ a y.
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param b Коэффициенты прямой связи.
+     * @param nB Размер массива b (1 ... 3).
+     * @param a Коэффициенты обратной связи.
+     * @param nA Размер массива a (0 ... 2).
+     * @param format Формат (DSP_Q15, DSP_Q31).
+     * @param rounding Режим округления (DSP_ROUND_*).
+     */
+    API_EXPORT void addFixedBiquad(void* systemPtr, const char* name, const double* b, int nB, const double* a, int nA,
+        int format, int rounding);
+
+    /**
+     * @brief Добавляет сумматор с фиксированной точкой и насыщением: y = sat(u * x1 + v * x2).
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param u Весовой коэффициент первого входа.
+     * @param v Весовой коэффициент второго входа.
+     * @param format Формат (DSP_Q15, DSP_Q31).
+     * @param rounding Режим округления (DSP_ROUND_*).
+     */
+    API_EXPORT void addFixedSummator(void* systemPtr, const char* name, double u, double v, int format, int rounding);
+
+    /**
+     * @brief Оценивает потери от перевода фильтра в фиксированную точку.
+     * @details Фильтр с nA == 0 рассматривается как КИХ (addFixedFIR), иначе как биквадратная
+     * секция (addFixedBiquad). Отношение сигнал/шум измеряется по выходам фильтра в double
+     * и фильтра с фиксированной точкой на белом шуме со среднеквадратичным значением 0.125.
+     * @param b Коэффициенты прямой связи.
+     * @param nB Размер массива b.
+     * @param a Коэффициенты обратной связи (может быть nullptr при nA == 0).
+     * @param nA Размер массива a.
+     * @param format Формат (DSP_Q15, DSP_Q31).
+     * @param rounding Режим округления (DSP_ROUND_*).
+     * @param snrDb Отношение сигнал/шум в дБ (может быть nullptr).
+     * @param maxError Наибольшая ошибка квантования коэффициента (может быть nullptr).
+     * @return Запас по разрядам коэффициентов (формат Q(15 - s) или Q(31 - s)) или -1 при ошибке.
+     */
+    API_EXPORT int quantizationReport(const double* b, int nB, const double* a, int nA, int format, int rounding,
+        double* snrDb, double* maxError);
+
     /**
      * @brief Соединяет выходные порты нескольких блоков с входом целевого блока.
      * @param systemPtr Указатель на систему.
@@ -98,13 +269,414 @@ extern "C" {
      */
     API_EXPORT void processSignal(void* systemPtr, const char* blockName, const double* input, double* output, int length);
 
+    /**
+     * @brief Регистрирует точку съема: выход блока, который записывает processWithTaps.
+     * @details Точки съема позволяют за один проход получить выходы нескольких блоков
+     * (например, промежуточных каскадов) без повторного вычисления общих источников.
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя блока.
+     * @return Номер точки (индекс буфера в processWithTaps) или -1 при ошибке.
+     */
+    API_EXPORT int addTap(void* systemPtr, const char* blockName);
+
+    /**
+     * @brief Удаляет все точки съема системы.
+     * @param systemPtr Указатель на систему.
+     */
+    API_EXPORT void clearTaps(void* systemPtr);
+
+    /**
+     * @brief Обрабатывает сигнал за один проход и записывает выход каждой точки съема в свой буфер.
+     * @details Каждый блок вычисляется один раз за отсчет. Каждый блок, от которого зависит
+     * хотя бы одна точка съема, продвигается на length отсчетов и после вызова находится
+     * в том же состоянии, что и после processSignal для этой точки; блоки, от которых
+     * не зависит ни одна точка, не изменяются.
+     * @param systemPtr Указатель на систему.
+     * @param input Входные отсчеты (length значений) или nullptr — нулевой вход (графы с генераторами).
+     * @param outputs Массив указателей на буферы длины length, по одному на точку съема (в порядке addTap).
+     * @param length Количество отсчетов.
+     */
+    API_EXPORT void processWithTaps(void* systemPtr, const double* input, double* const* outputs, int length);
+
+    /**
+     * @brief Задает число потоков для обработки длинных сигналов в processSignal.
+     * @details Части графа без рекурсивного состояния (КИХ-фильтры, сумматоры, скользящие
+     * min/max) делятся на участки с перекрытием и считаются параллельно; БИХ-фильтры
+     * и другие блоки с состоянием — последовательно. Результат побитно совпадает
+     * с последовательной обработкой. Параллельный путь включается для сигналов
+     * длиннее 65536 отсчетов.
+     * @param systemPtr Указатель на систему.
+     * @param threads Число потоков: 1 — последовательно (по умолчанию), 0 — все доступные процессоры.
+     */
+    API_EXPORT void setProcessingThreads(void* systemPtr, int threads);
+
     /**
      * @brief Получает текст последней перехваченной ошибки (Exception).
      * @details Если функции API сталкиваются с C++ исключениями, они сохраняются во внутренний буфер.
+     * Буфер свой у каждого потока: ошибка относится к последнему вызову API в этом же потоке.
      * @return Указатель на C-строку с текстом ошибки или nullptr, если ошибок не было.
      */
     API_EXPORT const char* getLastError();
 
+    /*
+     * ===== Анализ фильтров =====
+     * Частотные характеристики вычисляются на равномерной сетке w[k] = pi * k / nPoints
+     * (рад/отсчет, от 0 до частоты Найквиста). Функции с параметрами systemPtr/blockName
+     * анализируют передаточную функцию от внешнего входа системы к выходу блока
+     * (с учетом всех блоков-источников) и не изменяют состояние блоков.
+     */
+
+    /**
+     * @brief Получает передаточную функцию H(z) = B(z) / A(z) от входа системы к выходу блока.
+     * @details Коэффициенты возвращаются в стандартной форме по степеням z^-1 (a[0] = 1).
+     * Если емкости массивов недостаточно, возвращаются только требуемые размеры.
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя анализируемого блока.
+     * @param b Массив для коэффициентов числителя (может быть nullptr).
+     * @param capB Емкость массива b.
+     * @param a Массив для коэффициентов знаменателя (может быть nullptr).
+     * @param capA Емкость массива a.
+     * @param nB Указатель для записи фактического числа коэффициентов числителя.
+     * @param nA Указатель для записи фактического числа коэффициентов знаменателя.
+     * @return 0 при успехе, 1 если емкости массивов недостаточно, -1 при ошибке.
+     */
+    API_EXPORT int getTransferFunction(void* systemPtr, const char* blockName, double* b, int capB, double* a, int capA, int* nB, int* nA);
+
+    /**
+     * @brief Вычисляет АЧХ и развернутую ФЧХ выхода блока.
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя анализируемого блока.
+     * @param nPoints Количество точек частотной сетки.
+     * @param magnitude Массив для |H| размера nPoints (может быть nullptr).
+     * @param phase Массив для фазы в радианах размера nPoints (может быть nullptr).
+     */
+    API_EXPORT void frequencyResponse(void* systemPtr, const char* blockName, int nPoints, double* magnitude, double* phase);
+
+    /**
+     * @brief Вычисляет групповую задержку выхода блока (в отсчетах).
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя анализируемого блока.
+     * @param nPoints Количество точек частотной сетки.
+     * @param delay Массив для результата размера nPoints.
+     */
+    API_EXPORT void groupDelay(void* systemPtr, const char* blockName, int nPoints, double* delay);
+
+    /**
+     * @brief Вычисляет импульсную характеристику выхода блока при нулевом состоянии.
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя анализируемого блока.
+     * @param output Массив для результата.
+     * @param length Количество отсчетов.
+     */
+    API_EXPORT void impulseResponse(void* systemPtr, const char* blockName, double* output, int length);
+
+    /**
+     * @brief Вычисляет переходную характеристику (отклик на единичную ступеньку) выхода блока.
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя анализируемого блока.
+     * @param output Массив для результата.
+     * @param length Количество отсчетов.
+     */
+    API_EXPORT void stepResponse(void* systemPtr, const char* blockName, double* output, int length);
+
+    /**
+     * @brief Находит нули и полюса передаточной функции выхода блока.
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя анализируемого блока.
+     * @param zerosRe Массив вещественных частей нулей.
+     * @param zerosIm Массив мнимых частей нулей.
+     * @param capZeros Емкость массивов нулей.
+     * @param polesRe Массив вещественных частей полюсов.
+     * @param polesIm Массив мнимых частей полюсов.
+     * @param capPoles Емкость массивов полюсов.
+     * @param nZeros Указатель для записи количества нулей.
+     * @param nPoles Указатель для записи количества полюсов.
+     * @return 0 при успехе, 1 если емкости массивов недостаточно, -1 при ошибке.
+     */
+    API_EXPORT int getPolesZeros(void* systemPtr, const char* blockName,
+        double* zerosRe, double* zerosIm, int capZeros,
+        double* polesRe, double* polesIm, int capPoles,
+        int* nZeros, int* nPoles);
+
+    /**
+     * @brief Проверяет устойчивость передаточной функции выхода блока (критерий Шура–Кона).
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя анализируемого блока.
+     * @return 1 — устойчива, 0 — неустойчива, -1 — ошибка.
+     */
+    API_EXPORT int isStable(void* systemPtr, const char* blockName);
+
+    /**
+     * @brief Вычисляет АЧХ и ФЧХ фильтра напрямую по коэффициентам, без создания системы.
+     * @details Коэффициенты задаются в тех же соглашениях, что и в addIIR:
+     * y[t] = Σ b[i] * x[t-i] + Σ a[j] * y[t-1-j]. Для КИХ-фильтра передайте a = nullptr, nA = 0.
+     * Предназначена для интерактивной перерисовки графиков при редактировании коэффициентов.
+     * @param b Коэффициенты прямой связи.
+     * @param nB Размер массива b.
+     * @param a Коэффициенты обратной связи (может быть nullptr).
+     * @param nA Размер массива a.
+     * @param nPoints Количество точек частотной сетки.
+     * @param magnitude Массив для |H| размера nPoints (может быть nullptr).
+     * @param phase Массив для фазы в радианах размера nPoints (может быть nullptr).
+     */
+    API_EXPORT void frequencyResponseCoeffs(const double* b, int nB, const double* a, int nA, int nPoints, double* magnitude, double* phase);
+
+    /**
+     * @brief Вычисляет групповую задержку фильтра напрямую по коэффициентам (соглашения addIIR).
+     * @param b Коэффициенты прямой связи.
+     * @param nB Размер массива b.
+     * @param a Коэффициенты обратной связи (может быть nullptr).
+     * @param nA Размер массива a.
+     * @param nPoints Количество точек частотной сетки.
+     * @param delay Массив для результата размера nPoints.
+     */
+    API_EXPORT void groupDelayCoeffs(const double* b, int nB, const double* a, int nA, int nPoints, double* delay);
+
+    /*
+     * ===== Проектирование фильтров =====
+     * Частоты нормированы к частоте Найквиста: 0 < f < 1. Результаты кэшируются
+     * по спецификации, повторный запрос с теми же параметрами выполняется мгновенно.
+     */
+
+    /** @brief Типы полосы для функций проектирования. */
+    enum { DSP_LOWPASS = 0, DSP_HIGHPASS = 1, DSP_BANDPASS = 2, DSP_BANDSTOP = 3 };
+
+    /** @brief Типы окон для designFIRWindow. */
+    enum { DSP_WINDOW_RECT = 0, DSP_WINDOW_HANN = 1, DSP_WINDOW_HAMMING = 2, DSP_WINDOW_BLACKMAN = 3, DSP_WINDOW_KAISER = 4 };
+
+    /** @brief Аналоговые прототипы для designIIR / designIIRSOS. */
+    enum { DSP_BUTTERWORTH = 0, DSP_CHEBYSHEV1 = 1, DSP_CHEBYSHEV2 = 2, DSP_ELLIPTIC = 3 };
+
+    /**
+     * @brief Проектирует КИХ-фильтр методом окон (windowed-sinc).
+     * @param numTaps Количество коэффициентов (нечетное для DSP_HIGHPASS и DSP_BANDSTOP).
+     * @param bandType Тип полосы (DSP_LOWPASS ... DSP_BANDSTOP).
+     * @param f1 Частота среза или нижняя граница полосы.
+     * @param f2 Верхняя граница полосы (для DSP_LOWPASS/DSP_HIGHPASS игнорируется).
+     * @param windowType Тип окна (DSP_WINDOW_*).
+     * @param beta Параметр окна Кайзера.
+     * @param taps Массив для результата размера numTaps (пригоден для addFIR).
+     * @return 0 при успехе, -1 при ошибке.
+     */
+    API_EXPORT int designFIRWindow(int numTaps, int bandType, double f1, double f2, int windowType, double beta, double* taps);
+
+    /**
+     * @brief Проектирует равноволновый КИХ-фильтр алгоритмом Паркса–Макклеллана.
+     * @param numTaps Количество коэффициентов.
+     * @param bands Границы полос парами (2 * nBands значений по возрастанию, от 0 до 1).
+     * @param desired Желаемое усиление в каждой полосе (nBands значений).
+     * @param weights Веса ошибки в каждой полосе (nBands значений) или nullptr.
+     * @param nBands Количество полос.
+     * @param taps Массив для результата размера numTaps.
+     * @return 0 при успехе, -1 при ошибке.
+     */
+    API_EXPORT int designFIRRemez(int numTaps, const double* bands, const double* desired, const double* weights, int nBands, double* taps);
+
+    /**
+     * @brief Проектирует БИХ-фильтр и возвращает коэффициенты в соглашениях addIIR.
+     * @details Коэффициенты обратной связи a соответствуют y[t] = Σ b[i]*x[t-i] + Σ a[j]*y[t-1-j],
+     * поэтому результат можно сразу передать в addIIR. Для полосовых и режекторных
+     * фильтров порядок результата равен 2 * order. Прямая форма высокого порядка теряет
+     * точность, поэтому порядок результата ограничен 12, а коэффициенты, частотная
+     * характеристика которых расходится с каскадом секций (низкие частоты среза), не
+     * возвращаются: для таких спецификаций используйте designIIRSOS.
+     * @param order Порядок аналогового прототипа.
+     * @param bandType Тип полосы (DSP_LOWPASS ... DSP_BANDSTOP).
+     * @param f1 Частота среза или нижняя граница полосы.
+     * @param f2 Верхняя граница полосы (для DSP_LOWPASS/DSP_HIGHPASS игнорируется).
+     * @param prototype Тип прототипа (DSP_BUTTERWORTH ... DSP_ELLIPTIC).
+     * @param rp Пульсации в полосе пропускания, дБ.
+     * @param rs Затухание в полосе задерживания, дБ.
+     * @param b Массив для коэффициентов прямой связи.
+     * @param capB Емкость массива b.
+     * @param a Массив для коэффициентов обратной связи.
+     * @param capA Емкость массива a.
+     * @param nB Указатель для записи количества коэффициентов b.
+     * @param nA Указатель для записи количества коэффициентов a.
+     * @return 0 при успехе, 1 если емкости массивов недостаточно, -1 при ошибке
+     * (в том числе если прямая форма недостаточно точна).
+     */
+    API_EXPORT int designIIR(int order, int bandType, double f1, double f2, int prototype, double rp, double rs,
+        double* b, int capB, double* a, int capA, int* nB, int* nA);
+
+    /**
+     * @brief Проектирует БИХ-фильтр в виде каскада биквадратных секций (SOS).
+     * @details Каждая секция занимает 5 значений [b0, b1, b2, a1, a2] в соглашениях addIIR:
+     * первые три передаются в addIIR как b, последние два — как a. Секции с полюсами,
+     * ближайшими к единичной окружности, идут последними. Каскадная форма численно
+     * устойчивее прямой формы для фильтров высокого порядка.
+     * @param order Порядок аналогового прототипа.
+     * @param bandType Тип полосы.
+     * @param f1 Частота среза или нижняя граница полосы.
+     * @param f2 Верхняя граница полосы.
+     * @param prototype Тип прототипа.
+     * @param rp Пульсации в полосе пропускания, дБ.
+     * @param rs Затухание в полосе задерживания, дБ.
+     * @param sos Массив для секций (5 * capSections значений).
+     * @param capSections Емкость массива в секциях.
+     * @param nSections Указатель для записи количества секций.
+     * @return 0 при успехе, 1 если емкости массива недостаточно, -1 при ошибке.
+     */
+    API_EXPORT int designIIRSOS(int order, int bandType, double f1, double f2, int prototype, double rp, double rs,
+        double* sos, int capSections, int* nSections);
+
+    /**
+     * @brief Очищает кэш спроектированных фильтров.
+     */
+    API_EXPORT void clearDesignCache();
+
+    /** @brief Масштаб значений спектрограммы для addSTFT. */
+    enum { DSP_STFT_MAGNITUDE = 0, DSP_STFT_POWER = 1, DSP_STFT_DB = 2 };
+
+    /**
+     * @brief Обработчик кадра спектрограммы.
+     * @param frame Значения бинов кадра (nBins значений, действительны только во время вызова).
+     * @param nBins Количество бинов: nfft / 2 + 1.
+     * @param frameIndex Номер кадра с момента последнего сброса.
+     * @param userData Указатель, переданный в setSTFTCallback.
+     */
+    typedef void (*STFTFrameCallback)(const double* frame, int nBins, int frameIndex, void* userData);
+
+    /**
+     * @brief Добавляет блок кратковременного преобразования Фурье (STFT).
+     * @details Блок пропускает сигнал без изменений и каждые hop отсчетов вычисляет спектр
+     * последних windowLength отсчетов (окно периодическое, дополнение нулями до nfft).
+     * Первый кадр выдается после windowLength отсчетов.
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока.
+     * @param windowType Тип окна (DSP_WINDOW_*; для Кайзера beta = 8.6).
+     * @param windowLength Длина окна (от 1 до nfft).
+     * @param hop Шаг между кадрами (от 1 до windowLength).
+     * @param nfft Длина БПФ.
+     * @param scale Масштаб значений (DSP_STFT_MAGNITUDE, DSP_STFT_POWER, DSP_STFT_DB).
+     */
+    API_EXPORT void addSTFT(void* systemPtr, const char* name, int windowType, int windowLength, int hop, int nfft, int scale);
+
+    /**
+     * @brief Задает буфер спектрограммы для блока STFT.
+     * @details Буфер — матрица (nfft / 2 + 1) x maxFrames по строкам: бин k кадра f записывается
+     * в buffer[k * maxFrames + f % maxFrames]. Строки соответствуют частотам, столбцы — времени,
+     * поэтому буфер строится как изображение без перестановок. После maxFrames кадров запись
+     * продолжается с первого столбца; самый новый кадр находится в столбце (count - 1) % maxFrames,
+     * где count = getSTFTFrameCount().
+     * @param systemPtr Указатель на систему.
+     * @param name Имя блока STFT.
+     * @param buffer Буфер вызывающей стороны или nullptr, чтобы отключить запись.
+     * @param maxFrames Емкость буфера в кадрах.
+     */
+    API_EXPORT void setSTFTOutput(void* systemPtr, const char* name, double* buffer, int maxFrames);
+
+    /**
+     * @brief Задает обработчик кадров для блока STFT.
+     * @param systemPtr Указатель на систему.
+     * @param name Имя блока STFT.
+     * @param callback Функция, вызываемая для каждого кадра, или nullptr.
+     * @param userData Произвольный указатель, передаваемый в callback.
+     */
+    API_EXPORT void setSTFTCallback(void* systemPtr, const char* name, STFTFrameCallback callback, void* userData);
+
+    /**
+     * @brief Возвращает количество кадров, выданных блоком STFT с момента сброса.
+     * @param systemPtr Указатель на систему.
+     * @param name Имя блока STFT.
+     * @return Количество кадров или -1 при ошибке.
+     */
+    API_EXPORT int getSTFTFrameCount(void* systemPtr, const char* name);
+
+    /**
+     * @brief Добавляет блок обратного STFT (синтез перекрытием со сложением) для блока STFT.
+     * @details Блок получает комплексные кадры от stftName, вход блока автоматически
+     * соединяется с stftName. Без изменения спектра выход повторяет вход STFT с задержкой
+     * windowLength - 1 отсчетов (кроме отсчетов, где сумма окон равна нулю).
+     * @param systemPtr Указатель на систему.
+     * @param name Уникальное имя блока синтеза.
+     * @param stftName Имя существующего блока STFT.
+     */
+    API_EXPORT void addISTFT(void* systemPtr, const char* name, const char* stftName);
+
+
+    /**
+     * @brief Обработчик прогресса пакетной обработки.
+     * @param completed Количество завершенных заданий.
+     * @param total Общее количество заданий.
+     * @param userData Указатель, переданный в processBatch.
+     * @return 0 — продолжить, любое другое значение — отменить обработку.
+     */
+    typedef int (*BatchProgressCallback)(int completed, int total, void* userData);
+
+    /**
+     * @brief Параллельная обработка набора независимых сигналов.
+     * @details Каждый сигнал обрабатывается так, как если бы перед ним был вызван resetAll;
+     * состояние исходной системы не изменяется. Граф копируется на каждый рабочий поток,
+     * потоки закреплены за процессорами с учетом NUMA-узлов. Обработчик прогресса
+     * вызывается из рабочих потоков, но вызовы никогда не пересекаются.
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя блока, выход которого записывается в outputs.
+     * @param inputs Массив из nJobs указателей на входные сигналы.
+     * @param outputs Массив из nJobs указателей на выходные буферы.
+     * @param lengths Длины сигналов (nJobs значений).
+     * @param nJobs Количество сигналов.
+     * @param nThreads Наибольшее число потоков (0 или меньше — все доступные процессоры).
+     * @param progress Обработчик прогресса или nullptr.
+     * @param userData Произвольный указатель, передаваемый в progress.
+     * @return 0 при успехе, 1 если обработка отменена (часть выходов не заполнена), -1 при ошибке.
+     */
+    API_EXPORT int processBatch(void* systemPtr, const char* blockName, const double* const* inputs, double* const* outputs,
+        const int* lengths, int nJobs, int nThreads, BatchProgressCallback progress, void* userData);
+
+    /**
+     * @brief Обработчик завершения асинхронного задания.
+     * @details Вызывается в потоке исполнителя библиотеки. Внутри обработчика getLastError()
+     * возвращает текст ошибки задания. Из обработчика нельзя вызывать waitAsync и destroySystem
+     * для той же системы (взаимная блокировка).
+     * @param jobId Номер задания, возвращенный submitProcess.
+     * @param status 0 — успешно, -1 — ошибка.
+     * @param userData Указатель, переданный в submitProcess.
+     */
+    typedef void (*ProcessCallback)(long long jobId, int status, void* userData);
+
+    /**
+     * @brief Ставит обработку сигнала (аналог processSignal) в очередь и сразу возвращает управление.
+     * @details Задание выполняется потоком внутреннего исполнителя. Задания одной системы
+     * выполняются строго по порядку постановки, задания разных систем — параллельно.
+     * Массивы input и output должны оставаться действительными до завершения задания;
+     * пока у системы есть незавершенные задания, ее нельзя использовать синхронно.
+     * Если callback равен nullptr, завершение помещается в очередь pollCompletion.
+     * @param systemPtr Указатель на систему.
+     * @param blockName Имя целевого выходного блока.
+     * @param input Массив входных отсчетов.
+     * @param output Массив для результата (размера length).
+     * @param length Количество отсчетов.
+     * @param callback Обработчик завершения или nullptr.
+     * @param userData Произвольный указатель, передаваемый в callback / pollCompletion.
+     * @return Номер задания (больше нуля); 0 — очередь заполнена (повторить позже); -1 — ошибка.
+     */
+    API_EXPORT long long submitProcess(void* systemPtr, const char* blockName, const double* input, double* output,
+        int length, ProcessCallback callback, void* userData);
+
+    /**
+     * @brief Извлекает одно завершенное задание из очереди завершений (без ожидания).
+     * @details Очередь содержит задания, поставленные без callback. Для задания с ошибкой
+     * ее текст доступен через getLastError() сразу после вызова.
+     * @param jobId [out] Номер задания.
+     * @param status [out] 0 — успешно, -1 — ошибка.
+     * @param userData [out] Указатель, переданный в submitProcess (может быть nullptr).
+     * @return 1, если задание извлечено; 0, если очередь пуста.
+     */
+    API_EXPORT int pollCompletion(long long* jobId, int* status, void** userData);
+
+    /**
+     * @brief Ожидает завершения всех асинхронных заданий системы.
+     * @param systemPtr Указатель на систему или nullptr (все задания всех систем).
+     */
+    API_EXPORT void waitAsync(void* systemPtr);
+
+    /**
+     * @brief Задает предел числа незавершенных асинхронных заданий (по умолчанию 1024).
+     * @param maxJobs Новый предел (больше нуля).
+     */
+    API_EXPORT void setAsyncQueueLimit(int maxJobs);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "api.h"
+
+// Типовая нагрузка библиотеки: используется для замеров и для сбора профиля PGO.
+// Запуск: benchmark [количество отсчетов]
+
+static const double PI = 3.14159265358979323846;
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, double ms, int samples) {
+    std::cout << name << ": " << ms << " ms";
+    if (samples > 0) std::cout << " (" << samples / ms / 1000.0 << " Msamples/s)";
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : (1 << 18);
+    if (n <= 0) n = 1 << 18;
+
+    // входной сигнал: две синусоиды и детерминированный шум
+    std::vector<double> input(n), output(n);
+    unsigned state = 12345u;
+    for (int t = 0; t < n; ++t) {
+        state = state * 1664525u + 1013904223u;
+        double noise = (state >> 8) / 16777216.0 - 0.5;
+        input[t] = std::sin(2.0 * PI * 0.01 * t) + 0.5 * std::sin(2.0 * PI * 0.3 * t) + 0.1 * noise;
+    }
+
+    void* sys = createSystem();
+
+    // проектирование (без кэша, чтобы нагрузка включала вычисления)
+    auto start = std::chrono::steady_clock::now();
+    clearDesignCache();
+    std::vector<double> fir(63), remez(101);
+    designFIRWindow(63, DSP_LOWPASS, 0.2, 0.0, DSP_WINDOW_KAISER, 8.0, fir.data());
+    double bands[] = { 0.0, 0.2, 0.25, 1.0 };
+    double desired[] = { 1.0, 0.0 };
+    designFIRRemez(101, bands, desired, nullptr, 2, remez.data());
+    double sos[5 * 4];
+    int nSections = 0;
+    designIIRSOS(8, DSP_LOWPASS, 0.1, 0.0, DSP_ELLIPTIC, 0.5, 60.0, sos, 4, &nSections);
+    report("design", elapsedMs(start), 0);
+
+    // граф: FIR -> каскад биквадов, параллельно Remez FIR, сумматор; спектрограмма на выходе
+    addFIR(sys, "FIR", fir.data(), static_cast<int>(fir.size()));
+    std::string prev = "FIR";
+    for (int s = 0; s < nSections; ++s) {
+        std::string name = "SOS" + std::to_string(s);
+        addIIR(sys, name.c_str(), sos + 5 * s, 3, sos + 5 * s + 3, 2);
+        const char* src[] = { prev.c_str() };
+        connect(sys, name.c_str(), src, 1);
+        prev = name;
+    }
+    addFIR(sys, "Remez", remez.data(), static_cast<int>(remez.size()));
+    addSummator(sys, "Mix", 0.5, 0.5);
+    const char* mixSrc[] = { prev.c_str(), "Remez" };
+    connect(sys, "Mix", mixSrc, 2);
+    addSTFT(sys, "Spec", DSP_WINDOW_HANN, 512, 128, 512, DSP_STFT_DB);
+    const char* specSrc[] = { "Mix" };
+    connect(sys, "Spec", specSrc, 1);
+    std::vector<double> spectrogram(257 * 64);
+    setSTFTOutput(sys, "Spec", spectrogram.data(), 64);
+
+    if (getLastError()) {
+        std::cerr << "Setup failed: " << getLastError() << std::endl;
+        destroySystem(sys);
+        return 1;
+    }
+
+    start = std::chrono::steady_clock::now();
+    processSignal(sys, "Spec", input.data(), output.data(), n);
+    report("graph", elapsedMs(start), n);
+
+    resetAll(sys);
+    start = std::chrono::steady_clock::now();
+    processSignal(sys, "FIR", input.data(), output.data(), n);
+    report("fir63", elapsedMs(start), n);
+
+    // тот же граф без STFT на всех потоках: КИХ-часть считается участками с перекрытием
+    setProcessingThreads(sys, 0);
+    resetAll(sys);
+    start = std::chrono::steady_clock::now();
+    processSignal(sys, "Mix", input.data(), output.data(), n);
+    report("mix-parallel", elapsedMs(start), n);
+    setProcessingThreads(sys, 1);
+
+    // короткие фильтры (специализированные FixedFIR / FixedIIR)
+    double ma5[] = { 0.2, 0.2, 0.2, 0.2, 0.2 };
+    addFIR(sys, "MA5", ma5, 5);
+    resetAll(sys);
+    start = std::chrono::steady_clock::now();
+    processSignal(sys, "MA5", input.data(), output.data(), n);
+    report("fir5", elapsedMs(start), n);
+
+    resetAll(sys);
+    start = std::chrono::steady_clock::now();
+    processSignal(sys, "SOS0", input.data(), output.data(), n);
+    report("biquad", elapsedMs(start), n);
+
+    // тот же КИХ-фильтр в фиксированной точке (Q15 / Q31, целочисленные векторные ядра)
+    std::vector<double> fixedOut(n);
+    addFixedFIR(sys, "FIR-Q15", fir.data(), static_cast<int>(fir.size()), DSP_Q15, DSP_ROUND_NEAREST);
+    addFixedFIR(sys, "FIR-Q31", fir.data(), static_cast<int>(fir.size()), DSP_Q31, DSP_ROUND_NEAREST);
+    start = std::chrono::steady_clock::now();
+    processSignal(sys, "FIR-Q15", input.data(), fixedOut.data(), n);
+    report("fir63-q15", elapsedMs(start), n);
+    start = std::chrono::steady_clock::now();
+    processSignal(sys, "FIR-Q31", input.data(), fixedOut.data(), n);
+    report("fir63-q31", elapsedMs(start), n);
+
+    // генераторы (свой буфер: контрольная сумма считается по выходу биквада)
+    std::vector<double> generated(n);
+    addSineGenerator(sys, "Sine", 1.0, 0.02, 0.0);
+    addNoiseGenerator(sys, "Pink", DSP_NOISE_PINK, 1.0, 12345);
+    start = std::chrono::steady_clock::now();
+    generateSignal(sys, "Sine", generated.data(), n);
+    report("sine-gen", elapsedMs(start), n);
+    start = std::chrono::steady_clock::now();
+    generateSignal(sys, "Pink", generated.data(), n);
+    report("pink-gen", elapsedMs(start), n);
+
+    // анализ
+    std::vector<double> mag(4096), phase(4096);
+    start = std::chrono::steady_clock::now();
+    frequencyResponse(sys, "Mix", 4096, mag.data(), phase.data());
+    report("analysis", elapsedMs(start), 0);
+
+    double checksum = 0.0;
+    for (int t = 0; t < n; ++t) checksum += output[t];
+    std::cout << "checksum: " << checksum << std::endl;
+
+    destroySystem(sys);
+    return 0;
+}
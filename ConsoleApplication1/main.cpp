@@ -4,6 +4,7 @@
 #include "IIRFilter.h"
 #include "Summator.h"
 #include "ProcessingSystem.h"
+#include "FixedFilters.h"
 
 int main() {
     FIRFilter fir("FIR1", { 0.5, 0.5 });
@@ -27,12 +28,12 @@ int main() {
 
         // Добавляем FIR фильтр
         std::vector<double> firCoeffs = { 0.2, 0.2, 0.2, 0.2, 0.2 };
-        system.addBlock(std::make_unique<FIRFilter>("FIR1", firCoeffs));
+        system.addBlock(FilterFactory::makeFIR("FIR1", firCoeffs)); // 5 коэффициентов — FixedFIR<5>
 
         // Добавляем IIR фильтр
         std::vector<double> iirB = { 0.1, 0.1 };
         std::vector<double> iirA = { 1.0, -0.9 };
-        system.addBlock(std::make_unique<IIRFilter>("IIR2", iirB, iirA));
+        system.addBlock(FilterFactory::makeIIR("IIR2", iirB, iirA)); // FixedIIR<2, 2>
 
         // Добавляем сумматор с коэффициентами u=1.0, v=1.0
         system.addBlock(std::make_unique<Summator>("SUM1", 1.0, 1.0));
@@ -0,0 +1,414 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "api.h"
+
+// Регрессионный прогон: фиксированный набор графов на псевдослучайном шуме с заданным зерном.
+// Выходы сравниваются с эталонами (<граф>.golden), а скорость, пиковая память и число
+// выделений памяти — с сохраненной базой (baseline.txt).
+// Запуск: regression --data DIR [--update] [--threshold X] [--speed-threshold X] [--no-speed] [--length N]
+//   --update           перезаписать эталоны и базу текущими результатами
+//   --threshold        допустимый рост памяти и числа выделений (доля, по умолчанию 0.25)
+//   --speed-threshold  допустимый рост стоимости отсчета (доля, по умолчанию 1.0: вдвое медленнее)
+//   --no-speed         не проверять скорость (отладочная или инструментированная сборка)
+
+// ----- Счетчик выделений памяти: глобальные operator new / delete процесса (и библиотеки) -----
+
+static std::atomic<size_t> g_allocations{ 0 };
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// ----- Пиковый резидентный объем (Linux: VmHWM, сбрасывается записью в clear_refs) -----
+
+static long peakRssKb() {
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::atol(line.c_str() + 6);
+#endif
+    return 0; // нет данных: проверка памяти пропускается
+}
+
+static void resetPeakRss() {
+#ifdef __linux__
+    std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+// ----- Набор графов -----
+
+static const int GOLDEN_LENGTH = 4096; // отсчетов в эталоне
+static const int RUNS = 5;             // замеров скорости (берется лучший) ...
+static const double MIN_TIME_MS = 200; // ... но не меньше этого времени на граф
+
+struct Case {
+    std::string name;                         // имя графа (и файла эталона)
+    double maxUlps;                           // допустимое отличие от эталона, ULP пикового значения
+    std::function<std::string(void*)> build;  // строит граф, возвращает имя выходного блока
+};
+
+// Коэффициенты вычисляются здесь по явным формулам, а не функциями проектирования
+// библиотеки: итерационное проектирование (эллиптические фильтры) зависит от флагов
+// компиляции, а эталоны должны проверять саму обработку.
+
+static const double PI = 3.14159265358979323846;
+
+// КИХ-фильтр нижних (f2 = 0) или полосовых частот: окно Хэмминга на идеальной характеристике
+static std::vector<double> windowedSinc(int n, double f1, double f2) {
+    std::vector<double> taps(n);
+    for (int i = 0; i < n; ++i) {
+        double m = i - (n - 1) / 2.0;
+        auto lowpass = [m](double f) { return m == 0.0 ? f : std::sin(PI * f * m) / (PI * m); };
+        double ideal = f2 > 0.0 ? lowpass(f2) - lowpass(f1) : lowpass(f1);
+        taps[i] = ideal * (0.54 - 0.46 * std::cos(2.0 * PI * i / (n - 1)));
+    }
+    return taps;
+}
+
+// биквад нижних частот с полюсами r * exp(±j*theta) и двойным нулем в z = -1, усиление 1 на нуле
+static std::vector<double> resonatorSection(double r, double theta) {
+    double a1 = 2.0 * r * std::cos(theta), a2 = -r * r;
+    double g = (1.0 - a1 - a2) / 4.0;
+    return { g, 2.0 * g, g, a1, a2 };
+}
+
+static std::vector<Case> corpus() {
+    std::vector<Case> cases;
+
+    // длинный КИХ-фильтр (общий FIRFilter)
+    cases.push_back({ "fir-long", 16.0, [](void* sys) {
+        std::vector<double> taps = windowedSinc(511, 0.1, 0.0);
+        addFIR(sys, "Out", taps.data(), 511);
+        return std::string("Out");
+    } });
+
+    // БИХ высокого порядка: каскад восьми биквадов (полюса все ближе к окружности)
+    cases.push_back({ "iir-sos", 1024.0, [](void* sys) {
+        std::string prev;
+        for (int s = 0; s < 8; ++s) {
+            std::vector<double> c = resonatorSection(0.9 + 0.01 * s, 0.05 + 0.02 * s);
+            std::string name = "S" + std::to_string(s);
+            addIIR(sys, name.c_str(), c.data(), 3, c.data() + 3, 2);
+            if (!prev.empty()) {
+                const char* src[] = { prev.c_str() };
+                connect(sys, name.c_str(), src, 1);
+            }
+            prev = name;
+        }
+        return prev;
+    } });
+
+    // те же полюса (четыре секции) в прямой форме восьмого порядка (общий IIRFilter)
+    cases.push_back({ "iir-direct", 1024.0, [](void* sys) {
+        std::vector<double> b = { 1.0 }, den = { 1.0 };
+        for (int s = 0; s < 4; ++s) {
+            std::vector<double> c = resonatorSection(0.9 + 0.01 * s, 0.05 + 0.02 * s);
+            std::vector<double> nb(b.size() + 2, 0.0), nd(den.size() + 2, 0.0);
+            for (size_t i = 0; i < b.size(); ++i)
+                for (int k = 0; k < 3; ++k) nb[i + k] += b[i] * c[k];
+            double q[] = { 1.0, -c[3], -c[4] }; // знаменатель 1 - a1 z^-1 - a2 z^-2
+            for (size_t i = 0; i < den.size(); ++i)
+                for (int k = 0; k < 3; ++k) nd[i + k] += den[i] * q[k];
+            b = nb;
+            den = nd;
+        }
+        std::vector<double> a(den.size() - 1);
+        for (size_t j = 0; j < a.size(); ++j) a[j] = -den[j + 1];
+        addIIR(sys, "Out", b.data(), static_cast<int>(b.size()), a.data(), static_cast<int>(a.size()));
+        return std::string("Out");
+    } });
+
+    // широкое дерево сумматоров: 64 коротких КИХ-фильтра, 63 сумматора
+    cases.push_back({ "summator-tree", 64.0, [](void* sys) {
+        std::vector<std::string> level;
+        for (int i = 0; i < 64; ++i) {
+            double taps[5];
+            for (int k = 0; k < 5; ++k) taps[k] = std::cos(0.1 * (i + 1) * (k + 1)) / 5.0;
+            level.push_back("L" + std::to_string(i));
+            addFIR(sys, level.back().c_str(), taps, 5);
+        }
+        for (int depth = 0; level.size() > 1; ++depth) {
+            std::vector<std::string> next;
+            for (size_t i = 0; i < level.size(); i += 2) {
+                next.push_back("M" + std::to_string(depth) + "_" + std::to_string(i / 2));
+                addSummator(sys, next.back().c_str(), 0.5, 0.5);
+                const char* src[] = { level[i].c_str(), level[i + 1].c_str() };
+                connect(sys, next.back().c_str(), src, 2);
+            }
+            level = next;
+        }
+        return level[0];
+    } });
+
+    // глубокая цепочка: 256 блоков разных типов
+    cases.push_back({ "deep-chain", 64.0, [](void* sys) {
+        double fir[] = { 0.25, 0.5, 0.25 }, b[] = { 0.5 }, a[] = { 0.5 };
+        std::string prev;
+        for (int i = 0; i < 256; ++i) {
+            std::string name = "C" + std::to_string(i);
+            if (i % 3 == 0) addFIR(sys, name.c_str(), fir, 3);
+            else if (i % 3 == 1) addIIR(sys, name.c_str(), b, 1, a, 1);
+            else addMovingAverage(sys, name.c_str(), 4);
+            if (!prev.empty()) {
+                const char* src[] = { prev.c_str() };
+                connect(sys, name.c_str(), src, 1);
+            }
+            prev = name;
+        }
+        return prev;
+    } });
+
+    // фиксированная точка: результат целочисленный и должен совпадать побитно
+    cases.push_back({ "fir-q15", 0.0, [](void* sys) {
+        std::vector<double> taps = windowedSinc(127, 0.2, 0.4);
+        addFixedFIR(sys, "Out", taps.data(), 127, DSP_Q15, DSP_ROUND_CONVERGENT);
+        return std::string("Out");
+    } });
+
+    return cases;
+}
+
+// ----- Замеры -----
+
+struct Metrics {
+    double ulps = 0.0;    // наибольшее отличие от эталона, ULP пикового значения
+    double msps = 0.0;    // миллионов отсчетов в секунду (лучший прогон)
+    double cost = 0.0;    // время отсчета в единицах эталонного умножения-сложения
+    long rssKb = 0;       // пиковый резидентный объем процесса, КБ
+    double allocs = 0.0;  // выделений памяти за прогон (после первого)
+};
+
+// время одного умножения-сложения с зависимостью по данным, нс: делает стоимость
+// отсчета сравнимой между машинами разной скорости
+static double referenceMacNs() {
+    const size_t n = 1024, repeats = 2000;
+    std::vector<double> x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = std::sin(0.001 * i);
+        y[i] = std::cos(0.002 * i);
+    }
+    double best = 1e300;
+    volatile double sink = 0.0;
+    for (int run = 0; run < RUNS; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < repeats; ++r) {
+            double acc = 0.0;
+            for (size_t i = 0; i < n; ++i) acc += x[i] * y[i];
+            x[r % n] += 1e-12; // не дает вынести цикл из повторов
+            sink = sink + acc;
+        }
+        best = std::min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best / static_cast<double>(n * repeats);
+}
+
+static bool readGolden(const std::string& path, std::vector<double>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    data.resize(static_cast<size_t>(file.tellg()) / sizeof(double));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(double)));
+    return static_cast<bool>(file);
+}
+
+static bool writeGolden(const std::string& path, const double* data, size_t n) {
+    // двоичный формат: double в порядке байтов машины (little-endian на x86 и ARM)
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(n * sizeof(double)));
+    return static_cast<bool>(file);
+}
+
+// наибольшее отличие в ULP пикового значения эталона (ошибка округления сумм
+// соизмерима с младшим разрядом самых больших слагаемых, а не текущего отсчета)
+static double ulpDistance(const std::vector<double>& golden, const double* output) {
+    double peak = 0.0;
+    for (double g : golden) peak = std::max(peak, std::abs(g));
+    double ulp = std::nextafter(peak, INFINITY) - peak;
+    double worst = 0.0;
+    for (size_t i = 0; i < golden.size(); ++i) {
+        if (std::memcmp(&golden[i], &output[i], sizeof(double)) == 0) continue;
+        double d = std::abs(golden[i] - output[i]);
+        worst = std::max(worst, std::isnan(d) ? INFINITY : d / ulp);
+    }
+    return worst;
+}
+
+static std::map<std::string, double> readBaseline(const std::string& path) {
+    std::map<std::string, double> values;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string name, metric;
+        double value;
+        if (fields >> name >> metric >> value) values[name + " " + metric] = value;
+    }
+    return values;
+}
+
+int main(int argc, char** argv) {
+    std::string dataDir;
+    bool update = false, checkSpeed = true;
+    double threshold = 0.25, speedThreshold = 1.0;
+    int length = 1 << 16;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--data" && hasValue) dataDir = argv[++i];
+        else if (arg == "--update") update = true;
+        else if (arg == "--no-speed") checkSpeed = false;
+        else if (arg == "--threshold" && hasValue) threshold = std::atof(argv[++i]);
+        else if (arg == "--speed-threshold" && hasValue) speedThreshold = std::atof(argv[++i]);
+        else if (arg == "--length" && hasValue) length = std::max(GOLDEN_LENGTH, std::atoi(argv[++i]));
+        else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 2;
+        }
+    }
+    if (dataDir.empty()) {
+        std::cerr << "Usage: regression --data DIR [--update] [--threshold X] [--speed-threshold X] [--no-speed] [--length N]" << std::endl;
+        return 2;
+    }
+    const std::string baselinePath = dataDir + "/baseline.txt";
+    std::map<std::string, double> baseline = readBaseline(baselinePath);
+
+    std::vector<double> input(length), output(length);
+    std::ostringstream newBaseline;
+    newBaseline << "# graph metric value (regression --update)\n";
+    int failures = 0;
+    auto fail = [&](const std::string& what) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ++failures;
+    };
+
+    uint64_t seed = 0;
+    for (const Case& c : corpus()) {
+        // вход: равномерный шум xorshift64 со своим зерном для каждого графа (вычисляется
+        // здесь, чтобы эталон не зависел от генераторов библиотеки и флагов компиляции)
+        uint64_t state = 0x9E3779B97F4A7C15ull * ++seed;
+        for (double& x : input) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            x = static_cast<double>(state >> 11) * 0x1.0p-53 - 0.5;
+        }
+
+        resetPeakRss();
+        void* sys = createSystem();
+        std::string out = c.build(sys);
+        if (getLastError()) {
+            fail(c.name + ": setup error: " + getLastError());
+            destroySystem(sys);
+            continue;
+        }
+
+        // эталонный цикл замеряется до и после графа: частота процессора могла измениться
+        Metrics m;
+        double macNs = referenceMacNs();
+        double bestMs = 1e300, totalMs = 0.0;
+        for (int run = 0; run < RUNS || totalMs < MIN_TIME_MS; ++run) {
+            resetAll(sys);
+            size_t before = g_allocations.load();
+            auto start = std::chrono::steady_clock::now();
+            processSignal(sys, out.c_str(), input.data(), output.data(), length);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            bestMs = std::min(bestMs, ms);
+            totalMs += ms;
+            m.allocs = static_cast<double>(g_allocations.load() - before);
+            if (run == 0) {
+                // первый прогон от начального состояния сверяется с эталоном
+                std::string goldenPath = dataDir + "/" + c.name + ".golden";
+                std::vector<double> golden;
+                if (update) {
+                    if (!writeGolden(goldenPath, output.data(), GOLDEN_LENGTH)) fail(c.name + ": cannot write " + goldenPath);
+                }
+                else if (!readGolden(goldenPath, golden) || golden.size() != static_cast<size_t>(GOLDEN_LENGTH)) {
+                    fail(c.name + ": missing or truncated golden file " + goldenPath + " (run with --update)");
+                }
+                else {
+                    m.ulps = ulpDistance(golden, output.data());
+                    if (m.ulps > c.maxUlps) {
+                        std::ostringstream what;
+                        what << c.name << ": output differs from golden by " << m.ulps << " ULP (limit " << c.maxUlps << ")";
+                        fail(what.str());
+                    }
+                }
+            }
+        }
+        if (getLastError()) fail(c.name + ": processing error: " + getLastError());
+        destroySystem(sys);
+        macNs = std::min(macNs, referenceMacNs());
+
+        m.msps = length / bestMs / 1000.0;
+        m.cost = bestMs * 1e6 / length / macNs;
+        m.rssKb = peakRssKb();
+        std::cout << std::left << std::setw(14) << c.name << std::right << std::fixed
+            << std::setprecision(2) << std::setw(9) << m.msps << " Msamples/s"
+            << std::setprecision(1) << std::setw(9) << m.cost << " MAC/sample"
+            << std::setw(9) << m.rssKb << " KB peak"
+            << std::setprecision(0) << std::setw(6) << m.allocs << " allocs"
+            << std::setprecision(2) << std::setw(8) << m.ulps << " ULP" << std::defaultfloat << std::endl;
+
+        newBaseline << c.name << " cost " << m.cost << "\n"
+            << c.name << " rss_kb " << m.rssKb << "\n"
+            << c.name << " allocs " << m.allocs << "\n";
+        if (update) continue;
+
+        // сравнение с базой: рост стоимости, памяти или числа выделений сверх порога
+        auto check = [&](const char* metric, double value, double limit, bool enabled) {
+            auto it = baseline.find(c.name + " " + metric);
+            if (it == baseline.end()) {
+                fail(c.name + ": no baseline for " + metric + " (run with --update)");
+                return;
+            }
+            if (enabled && value > it->second * (1.0 + limit)) {
+                std::ostringstream what;
+                what << c.name << ": " << metric << " regressed from " << it->second << " to " << value
+                    << " (threshold " << limit * 100.0 << "%)";
+                fail(what.str());
+            }
+        };
+        check("cost", m.cost, speedThreshold, checkSpeed);
+        check("rss_kb", static_cast<double>(m.rssKb), threshold, m.rssKb > 0);
+        check("allocs", m.allocs, threshold, true);
+    }
+
+    if (update) {
+        std::ofstream file(baselinePath);
+        file << newBaseline.str();
+        if (!file) {
+            std::cerr << "Cannot write " << baselinePath << std::endl;
+            return 1;
+        }
+        std::cout << "Golden files and baseline updated in " << dataDir << std::endl;
+        return failures ? 1 : 0;
+    }
+    if (failures) {
+        std::cerr << failures << " regression check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "No regressions." << std::endl;
+    return 0;
+}
@@ -2,6 +2,9 @@
 #include <vector>
 #include <cassert>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include "api.h"
 
 // Простой макрос для проверки
@@ -58,6 +61,534 @@ int main() {
     ASSERT_TRUE(err != nullptr, "Error should occur for missing block");
     std::cout << "Expected error caught: " << err << std::endl;
 
+    // Тест 6: Анализ фильтров
+    // Filter1 = [0.5, 0.5]: |H(0)| = 1, |H(pi/2)| = sqrt(2)/2, групповая задержка 0.5
+    double mag[4], phase[4], gd[4];
+    frequencyResponse(sys, "Filter1", 4, mag, phase);
+    ASSERT_TRUE(getLastError() == nullptr, "Frequency response");
+    ASSERT_TRUE(std::abs(mag[0] - 1.0) < 1e-9, "FIR |H(0)|");
+    ASSERT_TRUE(std::abs(mag[2] - std::sqrt(0.5)) < 1e-9, "FIR |H(pi/2)|");
+    ASSERT_TRUE(std::abs(phase[2] + 3.14159265358979 / 4.0) < 1e-9, "FIR phase(pi/2)");
+    groupDelay(sys, "Filter1", 4, gd);
+    ASSERT_TRUE(std::abs(gd[1] - 0.5) < 1e-9, "FIR group delay");
+
+    // Каскад FIR -> IIR: y = 0.2 x + 0.8 y[-1], полюс в 0.8
+    double ib[] = { 0.2 };
+    double ia[] = { 0.8 };
+    addIIR(sys, "Smooth", ib, 1, ia, 1);
+    const char* chain[] = { "Filter1" };
+    connect(sys, "Smooth", chain, 1);
+    ASSERT_TRUE(isStable(sys, "Smooth") == 1, "Cascade stability");
+
+    double h[3];
+    impulseResponse(sys, "Smooth", h, 3);
+    ASSERT_TRUE(std::abs(h[0] - 0.1) < 1e-12 && std::abs(h[1] - 0.18) < 1e-12 && std::abs(h[2] - 0.144) < 1e-12,
+        "Cascade impulse response");
+
+    double zr[4], zi[4], pr[4], pi[4];
+    int nz = 0, np = 0;
+    int pzStatus = getPolesZeros(sys, "Smooth", zr, zi, 4, pr, pi, 4, &nz, &np);
+    ASSERT_TRUE(pzStatus == 0 && np == 1 && std::abs(pr[0] - 0.8) < 1e-12, "Cascade pole location");
+    ASSERT_TRUE(nz == 1 && std::abs(zr[0] + 1.0) < 1e-12, "Cascade zero location");
+
+    double unstableA[] = { 1.5 };
+    double coeffMag[2];
+    frequencyResponseCoeffs(ib, 1, unstableA, 1, 2, coeffMag, nullptr);
+    ASSERT_TRUE(std::abs(coeffMag[0] - 0.2 / 0.5) < 1e-9, "Coefficient frequency response");
+
+    // Тест 7: Проектирование фильтров
+    // Баттерворт 2-го порядка, срез на половине Найквиста: b = [0.2929, 0.5858, 0.2929], a = [1, 0, 0.1716]
+    double db[3], da[2];
+    int nb = 0, na = 0;
+    int designStatus = designIIR(2, DSP_LOWPASS, 0.5, 0.0, DSP_BUTTERWORTH, 0.0, 0.0, db, 3, da, 2, &nb, &na);
+    ASSERT_TRUE(designStatus == 0 && nb == 3 && na == 2, "Butterworth design");
+    ASSERT_TRUE(std::abs(db[0] - 0.29289321881) < 1e-9 && std::abs(db[1] - 0.58578643763) < 1e-9, "Butterworth numerator");
+    ASSERT_TRUE(std::abs(da[0]) < 1e-12 && std::abs(da[1] + 0.17157287525) < 1e-9, "Butterworth feedback");
+
+    addIIR(sys, "Designed", db, nb, da, na);
+    double dcMag[1];
+    frequencyResponse(sys, "Designed", 1, dcMag, nullptr);
+    ASSERT_TRUE(std::abs(dcMag[0] - 1.0) < 1e-9, "Designed filter DC gain");
+
+    double taps[21];
+    ASSERT_TRUE(designFIRWindow(21, DSP_LOWPASS, 0.25, 0.0, DSP_WINDOW_HAMMING, 0.0, taps) == 0, "Windowed-sinc design");
+    double tapSum = 0.0;
+    for (double t : taps) tapSum += t;
+    ASSERT_TRUE(std::abs(tapSum - 1.0) < 1e-12 && std::abs(taps[0] - taps[20]) < 1e-15, "Windowed-sinc gain and symmetry");
+
+    double bandEdges[] = { 0.0, 0.2, 0.3, 1.0 };
+    double bandGain[] = { 1.0, 0.0 };
+    ASSERT_TRUE(designFIRRemez(21, bandEdges, bandGain, nullptr, 2, taps) == 0, "Parks-McClellan design");
+    ASSERT_TRUE(std::abs(taps[3] - taps[17]) < 1e-15, "Parks-McClellan symmetry");
+
+    // некорректные спецификации отклоняются и при заполненном кэше (NaN не должен найти чужой проект)
+    double nanEdges[] = { 0.0, NAN, 0.3, 1.0 };
+    ASSERT_TRUE(designFIRWindow(21, DSP_LOWPASS, NAN, 0.0, DSP_WINDOW_HAMMING, 0.0, taps) != 0 && getLastError() != nullptr,
+        "Windowed-sinc design rejects NaN cutoff with a warm cache");
+    ASSERT_TRUE(designFIRWindow(21, DSP_LOWPASS, 1.5, 0.0, DSP_WINDOW_HAMMING, 0.0, taps) != 0,
+        "Windowed-sinc design rejects out-of-range cutoff");
+    ASSERT_TRUE(designFIRRemez(21, nanEdges, bandGain, nullptr, 2, taps) != 0 && getLastError() != nullptr,
+        "Parks-McClellan design rejects NaN band edge with a warm cache");
+    ASSERT_TRUE(designIIR(2, DSP_LOWPASS, NAN, 0.0, DSP_BUTTERWORTH, 0.0, 0.0, db, 3, da, 2, &nb, &na) != 0
+        && getLastError() != nullptr, "IIR design rejects NaN cutoff with a warm cache");
+    ASSERT_TRUE(designIIR(4, DSP_LOWPASS, 0.25, 0.0, DSP_ELLIPTIC, 1.0, INFINITY, db, 3, da, 2, &nb, &na) == -1
+        && designIIR(4, DSP_LOWPASS, 0.25, 0.0, DSP_CHEBYSHEV1, INFINITY, 0.0, db, 3, da, 2, &nb, &na) == -1
+        && designIIR(4, DSP_LOWPASS, 0.25, 0.0, DSP_CHEBYSHEV2, 0.0, INFINITY, db, 3, da, 2, &nb, &na) == -1,
+        "IIR design rejects infinite ripple and attenuation");
+    // прямая форма высокого порядка не возвращается: тот же фильтр доступен каскадом
+    double highB[64], highA[64], highSos[5 * 32];
+    int nSec = 0;
+    ASSERT_TRUE(designIIR(30, DSP_LOWPASS, 0.01, 0.0, DSP_BUTTERWORTH, 0.0, 0.0, highB, 64, highA, 64, &nb, &na) == -1
+        && designIIR(10, DSP_LOWPASS, 0.01, 0.0, DSP_BUTTERWORTH, 0.0, 0.0, highB, 64, highA, 64, &nb, &na) == -1
+        && designIIR(10, DSP_LOWPASS, 0.2, 0.0, DSP_BUTTERWORTH, 0.0, 0.0, highB, 64, highA, 64, &nb, &na) == 0
+        && designIIRSOS(30, DSP_LOWPASS, 0.01, 0.0, DSP_BUTTERWORTH, 0.0, 0.0, highSos, 32, &nSec) == 0 && nSec == 15,
+        "Direct-form IIR design is refused where it loses precision");
+
+    // длинный фильтр: пульсации в полосе пропускания и подавления равны (равноволновое решение)
+    const int longTaps = 301;
+    std::vector<double> longFir(longTaps);
+    double narrowEdges[] = { 0.0, 0.2, 0.25, 1.0 };
+    ASSERT_TRUE(designFIRRemez(longTaps, narrowEdges, bandGain, nullptr, 2, longFir.data()) == 0, "Long Parks-McClellan design");
+    double passRipple = 0.0, stopRipple = 0.0;
+    for (int k = 0; k <= 4096; ++k) {
+        double f = k / 4096.0, re = 0.0, im = 0.0;
+        for (int n = 0; n < longTaps; ++n) {
+            re += longFir[n] * std::cos(3.14159265358979323846 * f * n);
+            im -= longFir[n] * std::sin(3.14159265358979323846 * f * n);
+        }
+        double mag = std::sqrt(re * re + im * im);
+        if (f <= 0.2) passRipple = std::max(passRipple, std::abs(mag - 1.0));
+        if (f >= 0.25) stopRipple = std::max(stopRipple, mag);
+    }
+    ASSERT_TRUE(stopRipple > 0.0 && stopRipple < 1e-5 && std::abs(passRipple / stopRipple - 1.0) < 0.15,
+        "Long Parks-McClellan design is equiripple");
+
+    // Тест 8: Спектрограмма и ресинтез
+    // Окно 16, шаг 4, БПФ 16: синусоида на 4-м бине дает максимум в строке 4
+    const double PI_T = 3.14159265358979323846;
+    addSTFT(sys, "Spec", DSP_WINDOW_HANN, 16, 4, 16, DSP_STFT_MAGNITUDE);
+    ASSERT_TRUE(getLastError() == nullptr, "Add STFT");
+    const int specFrames = 8, nBins = 9;
+    double spec[nBins * specFrames] = { 0 };
+    setSTFTOutput(sys, "Spec", spec, specFrames);
+    addISTFT(sys, "Resynth", "Spec");
+    ASSERT_TRUE(getLastError() == nullptr, "Add ISTFT");
+
+    const int sigLen = 64;
+    double sig[sigLen], resynth[sigLen];
+    for (int t = 0; t < sigLen; ++t) sig[t] = std::sin(2.0 * PI_T * 4.0 * t / 16.0) + 0.1 * t / sigLen;
+    processSignal(sys, "Resynth", sig, resynth, sigLen);
+    ASSERT_TRUE(getSTFTFrameCount(sys, "Spec") == 13, "STFT frame count");
+
+    int lastColumn = (13 - 1) % specFrames, peak = 0;
+    for (int k = 1; k < nBins; ++k)
+        if (spec[k * specFrames + lastColumn] > spec[peak * specFrames + lastColumn]) peak = k;
+    ASSERT_TRUE(peak == 4, "STFT spectral peak");
+
+    // Без изменения спектра синтез повторяет вход с задержкой 15 отсчетов
+    // (отсчет 0 теряется: периодическое окно Ханна равно нулю в начале)
+    double maxErr = 0.0;
+    for (int t = 16; t < sigLen; ++t) maxErr = std::max(maxErr, std::abs(resynth[t] - sig[t - 15]));
+    ASSERT_TRUE(maxErr < 1e-12, "ISTFT overlap-add reconstruction");
+
+    // Тест 9: Специализированные короткие фильтры
+    // Filter1 (2 коэффициента) создается как FixedFIR, фильтр из 9 коэффициентов — как FIRFilter;
+    // при одинаковых ненулевых коэффициентах выходы должны совпадать побитно
+    double padded[9] = { 0.5, 0.5 };
+    addFIR(sys, "Padded", padded, 9);
+    resetAll(sys);
+    double fixedOut[sigLen], genericOut[sigLen];
+    processSignal(sys, "Filter1", sig, fixedOut, sigLen);
+    processSignal(sys, "Padded", sig, genericOut, sigLen);
+    bool identical = true;
+    for (int t = 0; t < sigLen; ++t) identical = identical && fixedOut[t] == genericOut[t];
+    ASSERT_TRUE(identical, "FixedFIR matches FIRFilter");
+
+    // Тест 10: Скользящая статистика
+    // Скользящее среднее совпадает с КИХ-фильтром 1/N; min/max/медиана — на известной последовательности
+    const int maN = 12;
+    double maTaps[maN];
+    for (double& c : maTaps) c = 1.0 / maN;
+    addFIR(sys, "MAfir", maTaps, maN);
+    addMovingAverage(sys, "MA", maN);
+    ASSERT_TRUE(getLastError() == nullptr, "Add moving average");
+    resetAll(sys);
+    double maOut[sigLen], maRef[sigLen];
+    processSignal(sys, "MA", sig, maOut, sigLen);
+    processSignal(sys, "MAfir", sig, maRef, sigLen);
+    double maErr = 0.0;
+    for (int t = 0; t < sigLen; ++t) maErr = std::max(maErr, std::abs(maOut[t] - maRef[t]));
+    ASSERT_TRUE(maErr < 1e-14, "Moving average matches FIR");
+
+    // NaN и ±Inf влияют на выход, как у КИХ-фильтра, только maN отсчетов
+    double gapSig[sigLen];
+    for (int t = 0; t < sigLen; ++t) gapSig[t] = sig[t];
+    gapSig[5] = NAN;
+    gapSig[20] = INFINITY;
+    gapSig[22] = -INFINITY;
+    gapSig[40] = INFINITY;
+    processSignal(sys, "MA", gapSig, maOut, sigLen);
+    processSignal(sys, "MAfir", gapSig, maRef, sigLen);
+    bool sameSpecial = true;
+    maErr = 0.0;
+    for (int t = 0; t < sigLen; ++t) {
+        if (!std::isfinite(maRef[t])) sameSpecial = sameSpecial && (std::isnan(maRef[t]) ? std::isnan(maOut[t]) : maOut[t] == maRef[t]);
+        else if (t >= 40 + maN) maErr = std::max(maErr, std::abs(maOut[t] - maRef[t]));
+        else sameSpecial = sameSpecial && std::isfinite(maOut[t]);
+    }
+    ASSERT_TRUE(sameSpecial && maErr < 1e-14, "Moving average recovers from NaN and Inf like FIR");
+
+    double rmsIn[12] = { NAN, 1e200, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+    double rmsOut[12];
+    addMovingRMS(sys, "RMSgap", 4);
+    processSignal(sys, "RMSgap", rmsIn, rmsOut, 12);
+    ASSERT_TRUE(std::isnan(rmsOut[0]) && std::isnan(rmsOut[3]) && std::isinf(rmsOut[4]) && rmsOut[5] == 1.0 && rmsOut[11] == 1.0,
+        "Moving RMS recovers from NaN and overflow");
+
+    double seq[] = { 3.0, 1.0, 4.0, 1.0, 5.0, 9.0, 2.0, 6.0 };
+    double seqOut[8];
+    addMovingMin(sys, "Min3", 3);
+    addMovingMax(sys, "Max3", 3);
+    addMovingMedian(sys, "Med3", 3);
+    addMovingRMS(sys, "RMS2", 2);
+    processSignal(sys, "Min3", seq, seqOut, 8);
+    ASSERT_TRUE(seqOut[0] == 3.0 && seqOut[2] == 1.0 && seqOut[4] == 1.0 && seqOut[5] == 1.0 && seqOut[6] == 2.0, "Moving min");
+    processSignal(sys, "Max3", seq, seqOut, 8);
+    ASSERT_TRUE(seqOut[1] == 3.0 && seqOut[3] == 4.0 && seqOut[5] == 9.0 && seqOut[7] == 9.0, "Moving max");
+    processSignal(sys, "Med3", seq, seqOut, 8);
+    ASSERT_TRUE(seqOut[1] == 2.0 && seqOut[2] == 3.0 && seqOut[3] == 1.0 && seqOut[5] == 5.0 && seqOut[7] == 6.0, "Moving median");
+    addMovingMedian(sys, "Med2", 2);
+    processSignal(sys, "Med2", seq, seqOut, 8);
+    ASSERT_TRUE(seqOut[0] == 3.0 && seqOut[1] == 2.0 && seqOut[2] == 2.5 && seqOut[5] == 7.0 && seqOut[7] == 4.0, "Moving median (even window)");
+    // NaN пропускается: медиана по остальным отсчетам окна, NaN — только если окно из одних NaN
+    double gappy[] = { 1.0, NAN, 3.0, NAN, NAN, NAN, 5.0, 2.0, 8.0 };
+    double gappyOut[9];
+    addMovingMedian(sys, "MedNaN", 3);
+    processSignal(sys, "MedNaN", gappy, gappyOut, 9);
+    ASSERT_TRUE(gappyOut[0] == 1.0 && gappyOut[1] == 1.0 && gappyOut[2] == 2.0 && gappyOut[3] == 3.0 && gappyOut[4] == 3.0
+        && std::isnan(gappyOut[5]) && gappyOut[6] == 5.0 && gappyOut[7] == 3.5 && gappyOut[8] == 5.0, "Moving median skips NaN");
+    processSignal(sys, "RMS2", seq, seqOut, 8);
+    ASSERT_TRUE(std::abs(seqOut[1] - std::sqrt(5.0)) < 1e-12 && std::abs(seqOut[5] - std::sqrt(53.0)) < 1e-12, "Moving RMS");
+
+    // Тест 11: Пакетная обработка
+    // Каждое задание совпадает с последовательной обработкой после resetAll
+    const int nJobs = 6;
+    std::vector<std::vector<double>> jobIn(nJobs), jobOut(nJobs), jobRef(nJobs);
+    const double* inPtr[nJobs];
+    double* outPtr[nJobs];
+    int jobLen[nJobs];
+    for (int j = 0; j < nJobs; ++j) {
+        jobLen[j] = 50 + 13 * j;
+        for (int t = 0; t < jobLen[j]; ++t) jobIn[j].push_back(std::sin(0.1 * (j + 1) * t));
+        jobOut[j].assign(jobLen[j], 0.0);
+        jobRef[j].assign(jobLen[j], 0.0);
+        inPtr[j] = jobIn[j].data();
+        outPtr[j] = jobOut[j].data();
+        resetAll(sys);
+        processSignal(sys, "Smooth", jobIn[j].data(), jobRef[j].data(), jobLen[j]);
+    }
+    ASSERT_TRUE(processBatch(sys, "Smooth", inPtr, outPtr, jobLen, nJobs, 0, nullptr, nullptr) == 0, "Batch processing");
+    bool batchMatch = true;
+    for (int j = 0; j < nJobs; ++j) batchMatch = batchMatch && jobOut[j] == jobRef[j];
+    ASSERT_TRUE(batchMatch, "Batch matches serial processing");
+
+    // Отмена из обработчика прогресса после первого задания
+    auto cancelAfterFirst = [](int completed, int, void* user) {
+        *static_cast<int*>(user) = completed;
+        return 1;
+    };
+    int lastCompleted = 0;
+    ASSERT_TRUE(processBatch(sys, "Smooth", inPtr, outPtr, jobLen, nJobs, 1, cancelAfterFirst, &lastCompleted) == 1
+        && lastCompleted == 1, "Batch cancellation");
+    ASSERT_TRUE(processBatch(sys, "GhostBlock", inPtr, outPtr, jobLen, nJobs, 0, nullptr, nullptr) == -1
+        && getLastError() != nullptr, "Batch error for missing block");
+
+    // Тест 12: Параллельная обработка длинного сигнала
+    // КИХ-часть графа делится на участки с перекрытием, БИХ-часть считается последовательно;
+    // выходы и состояние после вызова должны побитно совпадать с последовательным путем
+    double pf1[33], pf2[9], pf3[] = { 0.2, -0.1, 0.4, -0.1, 0.2 };
+    for (int i = 0; i < 33; ++i) pf1[i] = std::sin(0.3 * i + 0.1) / (i + 1);
+    for (int i = 0; i < 9; ++i) pf2[i] = 1.0 / (i + 2);
+    double pb[] = { 0.1 }, pa[] = { 0.9 };
+    addFIR(sys, "PF1", pf1, 33);
+    addFIR(sys, "PF2", pf2, 9);
+    addMovingMin(sys, "PMin", 20);
+    addSummator(sys, "PSum", 0.7, 0.3);
+    addIIR(sys, "PIIR", pb, 1, pa, 1);
+    addFIR(sys, "PF3", pf3, 5);
+    const char* pf2Src[] = { "PF1" };
+    const char* sumSrc[] = { "PF2", "PMin" };
+    const char* iirSrc[] = { "PSum" };
+    const char* pf3Src[] = { "PIIR" };
+    connect(sys, "PF2", pf2Src, 1);
+    connect(sys, "PSum", sumSrc, 2);
+    connect(sys, "PIIR", iirSrc, 1);
+    connect(sys, "PF3", pf3Src, 1);
+
+    const int longLen = 300000;
+    std::vector<double> longIn(longLen);
+    for (int t = 0; t < longLen; ++t) longIn[t] = std::sin(0.001 * t * (1.0 + 0.0001 * t)) + 0.01 * ((t % 101) * 37 % 101);
+    std::vector<double> serialOut(2 * longLen + 100), parallelOut(2 * longLen + 100);
+    for (int threads : { 1, 4 }) {
+        std::vector<double>& out = (threads == 1) ? serialOut : parallelOut;
+        setProcessingThreads(sys, threads);
+        resetAll(sys);
+        processSignal(sys, "PSum", longIn.data(), out.data(), 100000);
+        processSignal(sys, "PSum", longIn.data() + 100000, out.data() + 100000, longLen - 100000);
+        processSignal(sys, "PF3", longIn.data(), out.data() + longLen, longLen);
+        processSignal(sys, "PSum", longIn.data(), out.data() + 2 * longLen, 100);
+    }
+    ASSERT_TRUE(getLastError() == nullptr, "Parallel processing");
+    ASSERT_TRUE(serialOut == parallelOut, "Parallel processing matches serial");
+    setProcessingThreads(sys, 1);
+
+    // Тест 13: Асинхронная обработка
+    // Задания одной системы выполняются по порядку: две половины сигнала дают тот же
+    // результат, что и последовательные вызовы processSignal
+    const int half = longLen / 2;
+    std::vector<double> asyncOut(longLen);
+    resetAll(sys);
+    processSignal(sys, "PSum", longIn.data(), serialOut.data(), half);
+    processSignal(sys, "PSum", longIn.data() + half, serialOut.data() + half, longLen - half);
+    resetAll(sys);
+    int tag = 7;
+    long long job1 = submitProcess(sys, "PSum", longIn.data(), asyncOut.data(), half, nullptr, &tag);
+    long long job2 = submitProcess(sys, "PSum", longIn.data() + half, asyncOut.data() + half, longLen - half, nullptr, nullptr);
+    ASSERT_TRUE(job1 > 0 && job2 > job1, "Submit async jobs");
+    waitAsync(sys);
+    long long doneId[2] = { 0, 0 };
+    int doneStatus[2] = { -1, -1 };
+    void* doneUser[2] = { nullptr, nullptr };
+    int polled = pollCompletion(&doneId[0], &doneStatus[0], &doneUser[0]);
+    polled += pollCompletion(&doneId[1], &doneStatus[1], &doneUser[1]);
+    ASSERT_TRUE(polled == 2 && pollCompletion(nullptr, nullptr, nullptr) == 0, "Poll completions");
+    ASSERT_TRUE(doneId[0] == job1 && doneId[1] == job2 && doneStatus[0] == 0 && doneStatus[1] == 0
+        && doneUser[0] == &tag, "Completion order and user data");
+    ASSERT_TRUE(std::equal(serialOut.begin(), serialOut.begin() + longLen, asyncOut.begin()), "Async matches serial");
+
+    // Ошибка задания передается в callback (getLastError внутри callback)
+    static int callbackStatus = 0;
+    static bool callbackHasError = false;
+    submitProcess(sys, "GhostBlock", longIn.data(), asyncOut.data(), 10, [](long long, int status, void*) {
+        callbackStatus = status;
+        callbackHasError = getLastError() != nullptr;
+    }, nullptr);
+    waitAsync(sys);
+    ASSERT_TRUE(callbackStatus == -1 && callbackHasError, "Async error reported to callback");
+
+    // Предел очереди: пока первое задание не завершено (callback ждет), второе не принимается
+    static std::atomic<bool> release(false);
+    setAsyncQueueLimit(1);
+    long long blocking = submitProcess(sys, "PSum", longIn.data(), asyncOut.data(), 10, [](long long, int, void*) {
+        while (!release.load()) std::this_thread::yield();
+    }, nullptr);
+    long long rejected = submitProcess(sys, "PSum", longIn.data(), asyncOut.data(), 10, nullptr, nullptr);
+    release.store(true);
+    waitAsync(nullptr);
+    setAsyncQueueLimit(1024);
+    ASSERT_TRUE(blocking > 0 && rejected == 0, "Async queue limit");
+
+    // Тест 14: Генераторы сигналов
+    // Одинаковое зерно дает одинаковый шум при любом разбиении на порции и после resetAll
+    const int genLen = 100000;
+    addNoiseGenerator(sys, "GWhite", DSP_NOISE_WHITE, 2.0, 42);
+    addNoiseGenerator(sys, "GWhite2", DSP_NOISE_WHITE, 2.0, 42);
+    addNoiseGenerator(sys, "GWhite3", DSP_NOISE_WHITE, 2.0, 43);
+    addNoiseGenerator(sys, "GPink", DSP_NOISE_PINK, 1.0, 7);
+    ASSERT_TRUE(getLastError() == nullptr, "Add noise generators");
+    std::vector<double> white(genLen), white2(genLen), white3(genLen);
+    generateSignal(sys, "GWhite", white.data(), genLen);
+    generateSignal(sys, "GWhite2", white2.data(), 1000);
+    generateSignal(sys, "GWhite2", white2.data() + 1000, 37);
+    generateSignal(sys, "GWhite2", white2.data() + 1037, genLen - 1037);
+    generateSignal(sys, "GWhite3", white3.data(), genLen);
+    ASSERT_TRUE(white == white2, "Noise independent of chunking");
+    ASSERT_TRUE(white[0] != white3[0] && white[1] != white3[1], "Different seeds give different noise");
+    resetAll(sys);
+    for (int t = 0; t < 10; ++t) white2[t] = computeBlock(sys, "GWhite", 0.0);
+    generateSignal(sys, "GWhite", white2.data() + 10, genLen - 10);
+    ASSERT_TRUE(white == white2, "Noise restarts after resetAll");
+
+    // статистика: среднее, СКО и корреляция соседних отсчетов
+    auto moments = [](const std::vector<double>& x, double& sd, double& lag1) {
+        double mean = 0.0;
+        for (double v : x) mean += v;
+        mean /= x.size();
+        double var = 0.0, cov = 0.0;
+        for (size_t t = 0; t < x.size(); ++t) {
+            var += (x[t] - mean) * (x[t] - mean);
+            if (t > 0) cov += (x[t] - mean) * (x[t - 1] - mean);
+        }
+        sd = std::sqrt(var / x.size());
+        lag1 = cov / var;
+        return mean;
+    };
+    double sd, lag1;
+    double mean = moments(white, sd, lag1);
+    ASSERT_TRUE(std::abs(mean) < 0.05 && std::abs(sd - 2.0) < 0.03 && std::abs(lag1) < 0.02, "White noise statistics");
+    std::vector<double> pinkNoise(genLen);
+    generateSignal(sys, "GPink", pinkNoise.data(), genLen);
+    moments(pinkNoise, sd, lag1);
+    ASSERT_TRUE(std::abs(sd - 1.0) < 0.15 && lag1 > 0.5, "Pink noise statistics");
+
+    // детерминированные генераторы совпадают с формулами
+    addSineGenerator(sys, "GSine", 3.0, 0.01, 0.5);
+    addSquareGenerator(sys, "GSquare", 5.0, 0.05, 0.5);
+    addChirpGenerator(sys, "GChirp", 1.0, 0.0, 0.5, 1000);
+    ASSERT_TRUE(getLastError() == nullptr, "Add periodic generators");
+    std::vector<double> sine(genLen), square(genLen), chirp(genLen);
+    generateSignal(sys, "GSine", sine.data(), genLen);
+    generateSignal(sys, "GSquare", square.data(), genLen);
+    generateSignal(sys, "GChirp", chirp.data(), genLen);
+    double sineErr = 0.0, chirpErr = 0.0, squareSum = 0.0;
+    for (int t = 0; t < genLen; ++t) {
+        sineErr = std::max(sineErr, std::abs(sine[t] - 3.0 * std::sin(PI_T * 0.01 * t + 0.5)));
+        double tc = t % 1000;
+        double cycles = tc * (0.0 + 0.25 * tc / 2000.0);
+        chirpErr = std::max(chirpErr, std::abs(chirp[t] - std::sin(2.0 * PI_T * cycles)));
+        squareSum += square[t];
+    }
+    // эталон std::sin при аргументах ~3000 рад сам имеет погрешность ~1e-12
+    ASSERT_TRUE(sineErr < 1e-11, "Sine generator accuracy");
+    ASSERT_TRUE(chirpErr < 1e-9, "Chirp generator accuracy");
+    ASSERT_TRUE(square[5] == 5.0 && square[25] == -5.0 && std::abs(squareSum) <= 10.0, "Square generator");
+
+    // генератор как источник графа: фильтр получает его выход вместо внешнего входа
+    double avgTaps[] = { 0.5, 0.5 };
+    addFIR(sys, "GAvg", avgTaps, 2);
+    const char* genSrc[] = { "GSine" };
+    connect(sys, "GAvg", genSrc, 1);
+    resetAll(sys);
+    std::vector<double> smoothed(genLen);
+    generateSignal(sys, "GAvg", smoothed.data(), genLen);
+    double graphErr = std::abs(smoothed[0] - 0.5 * sine[0]);
+    for (int t = 1; t < genLen; ++t)
+        graphErr = std::max(graphErr, std::abs(smoothed[t] - 0.5 * (sine[t] + sine[t - 1])));
+    ASSERT_TRUE(getLastError() == nullptr && graphErr < 1e-15, "Generator feeds filter");
+
+    addSineGenerator(sys, "GBad", 1.0, 1.5, 0.0);
+    ASSERT_TRUE(getLastError() != nullptr, "Generator frequency above Nyquist rejected");
+    addNoiseGenerator(sys, "GBad", 5, 1.0, 1);
+    ASSERT_TRUE(getLastError() != nullptr, "Unknown noise color rejected");
+
+    // Тест 15: Точки съема
+    // Общий источник TS питает два каскада; за один проход точки съема дают выходы
+    // TS, TA и TSum, а TS продвигается один раз за отсчет — как в графе без общего блока
+    const int tapLen = 5000;
+    double tsTaps[] = { 0.25, 0.5, 0.25 };
+    double taB[] = { 0.3 }, taA[] = { 0.6 };
+    auto buildShared = [&](void* s, const char* src1, const char* src2) {
+        addFIR(s, src1, tsTaps, 3);
+        if (src2 != src1) addFIR(s, src2, tsTaps, 3);
+        addIIR(s, "TA", taB, 1, taA, 1);
+        addMovingMax(s, "TB", 4);
+        addSummator(s, "TSum", 1.0, -0.5);
+        const char* srcA[] = { src1 };
+        const char* srcB[] = { src2 };
+        const char* srcSum[] = { "TA", "TB" };
+        connect(s, "TA", srcA, 1);
+        connect(s, "TB", srcB, 1);
+        connect(s, "TSum", srcSum, 2);
+    };
+    buildShared(sys, "TS", "TS");
+    void* ref = createSystem();
+    buildShared(ref, "TS", "TS2");
+    ASSERT_TRUE(getLastError() == nullptr, "Build shared graph");
+
+    ASSERT_TRUE(addTap(sys, "TS") == 0 && addTap(sys, "TA") == 1 && addTap(sys, "TSum") == 2, "Add taps");
+    ASSERT_TRUE(addTap(sys, "TA") == 1, "Repeated tap keeps its index");
+    ASSERT_TRUE(addTap(sys, "NoSuchBlock") == -1 && getLastError() != nullptr, "Tap on missing block rejected");
+
+    std::vector<double> tapS(tapLen), tapA(tapLen), tapTotal(tapLen), refS(tapLen), refA(tapLen), refSum(tapLen);
+    double* tapOut[] = { tapS.data(), tapA.data(), tapTotal.data() };
+    resetAll(sys);
+    processWithTaps(sys, longIn.data(), tapOut, tapLen);
+    ASSERT_TRUE(getLastError() == nullptr, "Process with taps");
+    processSignal(ref, "TSum", longIn.data(), refSum.data(), tapLen);
+    resetAll(ref);
+    processSignal(ref, "TA", longIn.data(), refA.data(), tapLen);
+    resetAll(ref);
+    processSignal(ref, "TS", longIn.data(), refS.data(), tapLen);
+    ASSERT_TRUE(tapS == refS && tapA == refA && tapTotal == refSum, "Taps match graph without shared block");
+
+    // processSignal и computeBlock тоже не продвигают общий блок дважды
+    std::vector<double> serialSum(tapLen);
+    resetAll(sys);
+    processSignal(sys, "TSum", longIn.data(), serialSum.data(), tapLen);
+    ASSERT_TRUE(serialSum == refSum, "processSignal evaluates shared block once");
+    resetAll(sys);
+    bool sameSample = true;
+    for (int t = 0; t < 10; ++t) sameSample = sameSample && computeBlock(sys, "TSum", longIn[t]) == refSum[t];
+    ASSERT_TRUE(sameSample, "computeBlock evaluates shared block once");
+    destroySystem(ref);
+
+    // нулевой вход (nullptr): генератор и фильтр за ним из теста 14 за один проход
+    clearTaps(sys);
+    ASSERT_TRUE(addTap(sys, "GSine") == 0 && addTap(sys, "GAvg") == 1, "Retap after clearTaps");
+    std::vector<double> tapSine(genLen), tapAvg(genLen);
+    double* genOut[] = { tapSine.data(), tapAvg.data() };
+    resetAll(sys);
+    processWithTaps(sys, nullptr, genOut, genLen);
+    ASSERT_TRUE(getLastError() == nullptr && tapSine == sine && tapAvg == smoothed, "Taps on generator graph");
+
+    // Тест 16: Фиксированная точка (Q15 / Q31)
+    std::vector<double> qTaps(63);
+    designFIRWindow(63, DSP_LOWPASS, 0.2, 0.0, DSP_WINDOW_HAMMING, 0.0, qTaps.data());
+    addFIR(sys, "QRef", qTaps.data(), 63);
+    addFixedFIR(sys, "Q15F", qTaps.data(), 63, DSP_Q15, DSP_ROUND_NEAREST);
+    addFixedFIR(sys, "Q31F", qTaps.data(), 63, DSP_Q31, DSP_ROUND_CONVERGENT);
+    ASSERT_TRUE(getLastError() == nullptr, "Add fixed-point FIR filters");
+    const int qLen = 4000;
+    std::vector<double> qIn(qLen), qRef(qLen), q15(qLen), q31(qLen);
+    for (int t = 0; t < qLen; ++t) qIn[t] = 0.6 * std::sin(0.05 * t) + 0.3 * std::sin(0.9 * t);
+    processSignal(sys, "QRef", qIn.data(), qRef.data(), qLen);
+    processSignal(sys, "Q15F", qIn.data(), q15.data(), qLen);
+    processSignal(sys, "Q31F", qIn.data(), q31.data(), qLen);
+    double err15 = 0.0, err31 = 0.0;
+    for (int t = 0; t < qLen; ++t) {
+        err15 = std::max(err15, std::abs(q15[t] - qRef[t]));
+        err31 = std::max(err31, std::abs(q31[t] - qRef[t]));
+    }
+    ASSERT_TRUE(err15 < 1e-3 && err31 < 1e-8, "Fixed-point FIR follows double FIR");
+
+    // насыщение вместо переполнения: 0.75 + 0.75 -> 1 - 2^-15
+    double unity[] = { 1.0 };
+    addFixedFIR(sys, "QPass", unity, 1, DSP_Q15, DSP_ROUND_TRUNCATE);
+    addFixedSummator(sys, "QSum", 1.0, 1.0, DSP_Q15, DSP_ROUND_TRUNCATE);
+    const char* qSumSrc[] = { "QPass", "QPass" };
+    connect(sys, "QSum", qSumSrc, 2);
+    ASSERT_TRUE(computeBlock(sys, "QSum", 0.75) == 32767.0 / 32768.0
+        && computeBlock(sys, "QSum", -0.75) == -1.0, "Fixed-point summator saturates");
+
+    // биквад: передаточная функция с квантованными коэффициентами
+    double qb[] = { 0.2, 0.4, 0.2 }, qa[] = { 0.5, -0.3 };
+    addFixedBiquad(sys, "QBq", qb, 3, qa, 2, DSP_Q31, DSP_ROUND_NEAREST);
+    double qMag[8], qRefMag[8];
+    frequencyResponse(sys, "QBq", 8, qMag, nullptr);
+    frequencyResponseCoeffs(qb, 3, qa, 2, 8, qRefMag, nullptr);
+    double qMagErr = 0.0;
+    for (int k = 0; k < 8; ++k) qMagErr = std::max(qMagErr, std::abs(qMag[k] - qRefMag[k]));
+    ASSERT_TRUE(getLastError() == nullptr && qMagErr < 1e-6, "Fixed-point biquad response");
+
+    // отчет о квантовании: Q31 точнее Q15, запас по разрядам для |a1| > 1
+    double snr15 = 0.0, snr31 = 0.0, coefErr15 = 0.0, coefErr31 = 0.0;
+    int shift15 = quantizationReport(qTaps.data(), 63, nullptr, 0, DSP_Q15, DSP_ROUND_NEAREST, &snr15, &coefErr15);
+    int shift31 = quantizationReport(qTaps.data(), 63, nullptr, 0, DSP_Q31, DSP_ROUND_NEAREST, &snr31, &coefErr31);
+    ASSERT_TRUE(shift15 >= 0 && shift31 >= 0 && snr15 > 60.0 && snr31 > snr15 + 60.0
+        && coefErr15 <= std::ldexp(1.0, shift15 - 16) && coefErr31 < coefErr15, "Quantization report for FIR");
+    double resB[] = { 0.01 }, resA[] = { 1.8, -0.9 };
+    ASSERT_TRUE(quantizationReport(resB, 1, resA, 2, DSP_Q15, DSP_ROUND_CONVERGENT, nullptr, nullptr) == 1,
+        "Quantization report for biquad");
+
+    // неверные параметры
+    ASSERT_TRUE(quantizationReport(qb, 3, qa, 2, 16, DSP_ROUND_NEAREST, nullptr, nullptr) == -1
+        && getLastError() != nullptr, "Unknown fixed-point format is rejected");
+    addFixedFIR(sys, "QBad", qTaps.data(), 63, DSP_Q15, 7);
+    ASSERT_TRUE(getLastError() != nullptr, "Unknown rounding mode is rejected");
+    double qa3[] = { 0.5, -0.3, 0.1 };
+    addFixedBiquad(sys, "QBad", qb, 3, qa3, 3, DSP_Q15, DSP_ROUND_NEAREST);
+    ASSERT_TRUE(getLastError() != nullptr, "Biquad with three feedback coefficients is rejected");
+
     // Очистка
     destroySystem(sys);
     std::cout << "=== All Tests Passed ===" << std::endl;
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+#include <iostream>
+#include <vector>
+#include "api.h"
+
+// Регрессионный замер: тихий «хвост» после сигнала не должен замедлять БИХ-фильтры.
+// Без сброса денормализованных чисел обратная связь затухает в область subnormal,
+// и обработка хвоста на x86 становится в десятки раз медленнее обычного сигнала.
+
+static const int LEN = 500000;
+static const double MAX_RATIO = 2.5; // допустимое замедление хвоста относительно сигнала
+
+// лучшее время из нескольких запусков (от одинакового начального состояния)
+static double bestMs(void* sys, const char* block, const std::vector<double>& in, std::vector<double>& out) {
+    double best = 1e300;
+    for (int run = 0; run < 3; ++run) {
+        resetAll(sys);
+        auto start = std::chrono::steady_clock::now();
+        processSignal(sys, block, in.data(), out.data(), LEN);
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main() {
+    void* sys = createSystem();
+
+    // резонатор с полюсами r * exp(±jw), r = 0.9999: медленное затухание, как у узкополосных фильтров
+    const double r = 0.9999, w = 0.05;
+    double b[] = { 1.0 };
+    double a[] = { 2.0 * r * std::cos(w), -r * r, 0.0 }; // третий (нулевой) коэффициент — общий IIRFilter
+    addIIR(sys, "Resonator", b, 1, a, 3);
+    addIIR(sys, "Biquad", b, 1, a, 2); // FixedIIR<1, 2>
+    if (getLastError()) {
+        std::cerr << "Setup failed: " << getLastError() << std::endl;
+        return 1;
+    }
+
+    // хвост: слабый импульс, чтобы затухание дошло до денормализованных чисел за десятки тысяч отсчетов
+    std::vector<double> tail(LEN, 0.0), signal(LEN), out(LEN);
+    tail[0] = 1e-305;
+    for (int t = 0; t < LEN; ++t) signal[t] = std::sin(0.01 * t);
+
+    bool ok = true;
+    for (const char* block : { "Resonator", "Biquad" }) {
+        double signalMs = bestMs(sys, block, signal, out);
+        double tailMs = bestMs(sys, block, tail, out);
+
+#ifndef DSP_DENORMAL_DC
+        // проверка самого замера: хвост затухает до границы денормализованных чисел
+        // (с FTZ выход остается на уровне шума сброса ~DBL_MIN, без FTZ — уходит в subnormal)
+        double lastHalf = 0.0;
+        for (int t = LEN / 2; t < LEN; ++t) lastHalf = std::max(lastHalf, std::abs(out[t]));
+        if (lastHalf > 1e3 * DBL_MIN) {
+            std::cerr << "FAIL: " << block << " tail does not decay to the denormal range" << std::endl;
+            ok = false;
+        }
+#endif
+
+        double ratio = tailMs / signalMs;
+        std::cout << block << ": signal " << signalMs << " ms, silent tail " << tailMs << " ms (x" << ratio << ")" << std::endl;
+        if (ratio > MAX_RATIO) {
+            std::cerr << "FAIL: " << block << " silent tail is " << ratio << "x slower than signal" << std::endl;
+            ok = false;
+        }
+    }
+
+    destroySystem(sys);
+    if (!ok) return 1;
+    std::cout << "=== Denormal Test Passed ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "FixedPoint.h"
+#include "FIRFilter.h"
+#include "IIRFilter.h"
+
+// Фиксированная точка: векторные ядра против скалярных, округление, насыщение и шум квантования.
+// Скалярные ядра компилируются на любой платформе, поэтому сравнение выполняется и на x86.
+
+#define CHECK(condition, msg) \
+    if (!(condition)) { \
+        std::cerr << "FAIL: " << msg << std::endl; \
+        return 1; \
+    } else { \
+        std::cout << "OK: " << msg << std::endl; \
+    }
+
+static const double PI = 3.14159265358979323846;
+
+int main() {
+    std::cout << "kernel: " << FixedPoint::kernelName() << std::endl;
+    std::mt19937_64 rng(2024);
+
+    // 1. Ядра: все длины, включая хвосты, и предельные значения при допустимой сумме |a|
+    bool same15 = true, same31 = true;
+    for (size_t n = 0; n <= 80; ++n) {
+        std::uniform_int_distribution<int> sample(-32768, 32767);
+        std::vector<int16_t> a(n), b(n);
+        int limit = n ? std::min<int>(32767, static_cast<int>(65535 / n)) : 0; // Σ|a| < 2^16
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = static_cast<int16_t>(std::uniform_int_distribution<int>(-limit, limit)(rng));
+            b[i] = static_cast<int16_t>(sample(rng));
+        }
+        same15 = same15 && FixedPoint::dotQ15(a.data(), b.data(), n) == FixedPoint::dotQ15Scalar(a.data(), b.data(), n);
+        for (size_t i = 0; i < n; ++i) b[i] = -32768;
+        same15 = same15 && FixedPoint::dotQ15(a.data(), b.data(), n) == FixedPoint::dotQ15Scalar(a.data(), b.data(), n);
+
+        std::vector<int32_t> c(n), d(n);
+        int64_t limit31 = n ? static_cast<int64_t>(4294967295u / n) : 0; // Σ|c| < 2^32
+        for (size_t i = 0; i < n; ++i) {
+            c[i] = static_cast<int32_t>(std::max<int64_t>(-2147483647, std::min<int64_t>(2147483647,
+                std::uniform_int_distribution<int64_t>(-limit31, limit31)(rng))));
+            d[i] = static_cast<int32_t>(std::uniform_int_distribution<int64_t>(INT32_MIN, INT32_MAX)(rng));
+        }
+        same31 = same31 && FixedPoint::dotQ31(c.data(), d.data(), n) == FixedPoint::dotQ31Scalar(c.data(), d.data(), n);
+        for (size_t i = 0; i < n; ++i) d[i] = INT32_MIN;
+        same31 = same31 && FixedPoint::dotQ31(c.data(), d.data(), n) == FixedPoint::dotQ31Scalar(c.data(), d.data(), n);
+    }
+    CHECK(same15, "dotQ15 matches the scalar kernel");
+    CHECK(same31, "dotQ31 matches the scalar kernel");
+
+    // 2. Округление: x.5 в трех режимах, положительные и отрицательные значения
+    struct { int64_t acc; int64_t t, n, c; } cases[] = {
+        { 5, 2, 3, 2 }, { 7, 3, 4, 4 }, { -5, -3, -2, -2 }, { -7, -4, -3, -4 }, { 6, 3, 3, 3 }, { -3, -2, -1, -2 }
+    };
+    bool rounding = true;
+    for (const auto& k : cases) {
+        rounding = rounding && FixedPoint::shiftRound(k.acc, 1, Rounding::Truncate) == k.t
+            && FixedPoint::shiftRound(k.acc, 1, Rounding::Nearest) == k.n
+            && FixedPoint::shiftRound(k.acc, 1, Rounding::Convergent) == k.c
+            && FixedPoint::roundValue(k.acc / 2.0, Rounding::Truncate) == k.t
+            && FixedPoint::roundValue(k.acc / 2.0, Rounding::Nearest) == k.n
+            && FixedPoint::roundValue(k.acc / 2.0, Rounding::Convergent) == k.c;
+    }
+    CHECK(rounding, "Truncate / Nearest / Convergent rounding");
+
+    // 3. Насыщение при переводе из double
+    CHECK(FixedPoint::fromDouble<int16_t>(1.0, 15, Rounding::Nearest) == 32767
+        && FixedPoint::fromDouble<int16_t>(-1.0, 15, Rounding::Nearest) == -32768
+        && FixedPoint::fromDouble<int16_t>(-7.5, 15, Rounding::Nearest) == -32768
+        && FixedPoint::fromDouble<int32_t>(3.0, 31, Rounding::Nearest) == INT32_MAX
+        && FixedPoint::fromDouble<int16_t>(NAN, 15, Rounding::Nearest) == 0, "Saturating conversion from double");
+
+    // 4. КИХ Q15: блочная обработка совпадает с поотсчетной, сумма коэффициентов > 1 не переполняется
+    std::vector<double> lowpass(63);
+    for (int i = 0; i < 63; ++i) {
+        double m = i - 31.0;
+        double sinc = m == 0.0 ? 0.2 : std::sin(0.2 * PI * m) / (PI * m);
+        lowpass[i] = sinc * (0.54 - 0.46 * std::cos(2.0 * PI * i / 62.0));
+    }
+    std::vector<double> x(3000), y1(3000), y2(3000);
+    for (size_t t = 0; t < x.size(); ++t) x[t] = (t / 50) % 2 ? 0.999 : -1.0; // полная шкала
+    Q15FIR fir("Q15", lowpass);
+    fir.processBlock(x.data(), y1.data(), x.size());
+    fir.reset();
+    for (size_t t = 0; t < x.size(); ++t) y2[t] = fir.process({ x[t] });
+    CHECK(y1 == y2, "Q15 FIR block and per-sample outputs are identical");
+    double peak = 0.0;
+    for (double y : y1) peak = std::max(peak, std::fabs(y));
+    CHECK(peak <= 1.0 && peak > 0.9, "Q15 FIR output stays within full scale on a full-scale square wave");
+
+    // 5. Шум квантования: Q31 почти точен, Q15 — около 16 разрядов минус запас
+    FIRFilter reference("Ref", lowpass);
+    Q31FIR fir31("Q31", lowpass);
+    double snr15 = FixedPoint::measureSNR(reference, fir);
+    double snr31 = FixedPoint::measureSNR(reference, fir31);
+    std::cout << "FIR SNR: Q15 " << snr15 << " dB, Q31 " << snr31 << " dB" << std::endl;
+    CHECK(snr15 > 60.0 && snr31 > snr15 + 80.0, "FIR quantization SNR");
+
+    // биквад нижних частот (Баттерворт, fc = 0.1): y = Σ b x + a1 y1 + a2 y2
+    double k = std::tan(PI * 0.05), norm = 1.0 / (1.0 + std::sqrt(2.0) * k + k * k);
+    std::vector<double> bq = { k * k * norm, 2.0 * k * k * norm, k * k * norm };
+    std::vector<double> aq = { -2.0 * (k * k - 1.0) * norm, -(1.0 - std::sqrt(2.0) * k + k * k) * norm };
+    IIRFilter iir("Ref", bq, aq);
+    Q15Biquad biquad15("Q15", bq, aq, Rounding::Convergent);
+    Q31Biquad biquad31("Q31", bq, aq, Rounding::Convergent);
+    double snrBq15 = FixedPoint::measureSNR(iir, biquad15);
+    double snrBq31 = FixedPoint::measureSNR(iir, biquad31);
+    std::cout << "Biquad SNR: Q15 " << snrBq15 << " dB, Q31 " << snrBq31 << " dB" << std::endl;
+    CHECK(biquad15.headroom() == 1 && snrBq15 > 40.0 && snrBq31 > 120.0, "Biquad quantization SNR");
+
+    // 6. Насыщение обратной связи: резонатор на полной шкале не «заворачивается» через знак
+    Q15Biquad resonator("Res", { 0.5 }, { 1.9, -0.95 });
+    double high = 0.0, low = 0.0;
+    for (int t = 0; t < 2000; ++t) {
+        double y = resonator(t % 40 < 20 ? 1.0 : -1.0);
+        high = std::max(high, y);
+        low = std::min(low, y);
+    }
+    CHECK(high == 32767.0 / 32768.0 && low == -1.0, "Q15 biquad saturates instead of wrapping");
+
+    Q15FIR gain("Gain", { 2.0 });
+    CHECK(gain.process({ 0.75 }) == 32767.0 / 32768.0 && gain.process({ -0.75 }) == -1.0, "Q15 FIR saturates");
+
+    Q15Summator sum("Sum", 1.0, 1.0);
+    CHECK(sum(0.75, 0.75) == 32767.0 / 32768.0 && sum(-0.75, -0.75) == -1.0 && sum(0.25, -0.5) == -0.25,
+        "Q15 summator saturates");
+
+    std::cout << "All fixed-point tests passed." << std::endl;
+    return 0;
+}
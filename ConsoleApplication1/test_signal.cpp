@@ -61,3 +61,8 @@ void test_signal() {
 void runTest() {
 	test_signal();
 }
+
+int main() {
+	runTest();
+	return 0;
+}